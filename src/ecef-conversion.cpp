@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ecef-conversion.hpp"
+#include "polynomial-kernels.hpp"
+#include "wgs84.hpp"
+
+#include <cmath>
+
+namespace {
+    constexpr double DEG2RAD{M_PI / 180.0};
+
+    // Prime vertical radius of curvature A / sqrt(1 - u) with u = E2 * sin^2
+    // below 0.0067 from its binomial series; the truncation error is below
+    // 1e-15 in relative terms.
+    inline double primeVerticalRadius(const double &sinLatitude) noexcept {
+        const double U{WGS84::E2 * sinLatitude * sinLatitude};
+        return WGS84::A * (1.0 + U * (1.0 / 2.0 + U * (3.0 / 8.0 + U * (5.0 / 16.0 + U * (35.0 / 128.0 + U * (63.0 / 256.0 + U * (231.0 / 1024.0)))))));
+    }
+}
+
+void ECEFConversion::toECEF(const double &latitude, const double &longitude, const double &altitude, double &x, double &y, double &z) noexcept {
+    const double SIN_LATITUDE{std::sin(latitude * DEG2RAD)};
+    const double COS_LATITUDE{std::cos(latitude * DEG2RAD)};
+    const double N{WGS84::A / std::sqrt(1.0 - WGS84::E2 * SIN_LATITUDE * SIN_LATITUDE)};
+    x = (N + altitude) * COS_LATITUDE * std::cos(longitude * DEG2RAD);
+    y = (N + altitude) * COS_LATITUDE * std::sin(longitude * DEG2RAD);
+    z = (N * (1.0 - WGS84::E2) + altitude) * SIN_LATITUDE;
+}
+
+void ECEFConversion::toECEF(const double *__restrict__ latitude, const double *__restrict__ longitude, const double *__restrict__ altitude, double *__restrict__ x, double *__restrict__ y, double *__restrict__ z, const size_t &count) noexcept {
+    // Local copy as the stores could otherwise alias the referenced count.
+    const size_t COUNT{count};
+    for (size_t i{0}; i < COUNT; i++) {
+        double sinLatitude{0.0};
+        double cosLatitude{1.0};
+        PolynomialKernels::sinCos(latitude[i] * DEG2RAD, sinLatitude, cosLatitude);
+        double sinLongitude{0.0};
+        double cosLongitude{1.0};
+        PolynomialKernels::sinCos(longitude[i] * DEG2RAD, sinLongitude, cosLongitude);
+        const double N{primeVerticalRadius(sinLatitude)};
+        x[i] = (N + altitude[i]) * cosLatitude * cosLongitude;
+        y[i] = (N + altitude[i]) * cosLatitude * sinLongitude;
+        z[i] = (N * (1.0 - WGS84::E2) + altitude[i]) * sinLatitude;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECEF_CONVERSION
+#define ECEF_CONVERSION
+
+#include <cstddef>
+
+/**
+ * ECEFConversion converts WGS84 positions into earth-centered, earth-fixed
+ * coordinates in meters. The scalar conversion uses the library functions
+ * and serves as reference; the batch conversion for structure-of-arrays
+ * input, e.g., when reprocessing large logs offline, replaces them by
+ * polynomials without branches so that the compiler can process several
+ * positions per SIMD register (e.g., with -O3 on SSE2 or NEON). The batch
+ * results stay within 0.1 mm of the reference.
+ */
+class ECEFConversion {
+   private:
+    ECEFConversion() = delete;
+
+   public:
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param altitude Ellipsoidal height in meters.
+     */
+    static void toECEF(const double &latitude, const double &longitude, const double &altitude, double &x, double &y, double &z) noexcept;
+
+    /**
+     * Converts count positions; latitudes need to be within [-90, 90] and
+     * longitudes within [-180, 180] degrees as decoded from NMEA. The arrays
+     * must not overlap.
+     */
+    static void toECEF(const double *__restrict__ latitude, const double *__restrict__ longitude, const double *__restrict__ altitude, double *__restrict__ x, double *__restrict__ y, double *__restrict__ z, const size_t &count) noexcept;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gnss-date.hpp"
+#include "nmea-fields.hpp"
+
+bool GNSSDate::parseTimeOfDay(const char *timeOfDay, const size_t &length, int64_t &milliseconds) noexcept {
+    if ( (nullptr == timeOfDay) || (6 > length) || ((6 < length) && ('.' != timeOfDay[6])) ) {
+        return false;
+    }
+    uint64_t hhmmss{0};
+    if (!NMEAFields::parseDigits(timeOfDay, 6, hhmmss)) {
+        return false;
+    }
+    // Milliseconds only; further decimals are ignored.
+    const size_t DECIMALS{(6 < length) ? ((length - 7 < 3) ? length - 7 : 3) : 0};
+    uint64_t fraction{0};
+    if (!NMEAFields::parseDigits(timeOfDay + 7, DECIMALS, fraction)) {
+        return false;
+    }
+    static constexpr uint64_t SCALE[] = {1000, 100, 10, 1};
+    milliseconds = static_cast<int64_t>(((hhmmss / 10000) * 3600 + ((hhmmss / 100) % 100) * 60 + (hhmmss % 100)) * 1000 + fraction * SCALE[DECIMALS]);
+    return true;
+}
+
+int64_t GNSSDate::daysFromCivil(const int64_t &year, const int64_t &month, const int64_t &day) noexcept {
+    // Cf. http://howardhinnant.github.io/date_algorithms.html
+    const int64_t y{year - ((2 >= month) ? 1 : 0)};
+    const int64_t era{y / 400};
+    const int64_t yoe{y - era * 400};
+    const int64_t doy{(153 * (month + ((2 < month) ? -3 : 9)) + 2) / 5 + day - 1};
+    const int64_t doe{yoe * 365 + yoe / 4 - yoe / 100 + doy};
+    return era * 146097 + doe - 719468;
+}
+
+bool GNSSDate::setDate(const int64_t &year, const int64_t &month, const int64_t &day) noexcept {
+    if ( (1970 > year) || (1 > month) || (12 < month) || (1 > day) || (31 < day) ) {
+        return false;
+    }
+    // The conversion to days is only redone when the date changes.
+    const int64_t DATE{(year * 100 + month) * 100 + day};
+    if (DATE != m_date) {
+        m_days = daysFromCivil(year, month, day);
+        m_date = DATE;
+        m_ddmmyy = 0;
+    }
+    return true;
+}
+
+bool GNSSDate::setDate(const char *ddmmyy, const size_t &length) noexcept {
+    if ( (nullptr == ddmmyy) || (6 != length) ) {
+        return false;
+    }
+    uint64_t date{0};
+    if (!NMEAFields::parseDigits(ddmmyy, length, date)) {
+        return false;
+    }
+    // Unchanged dates are neither converted nor checked again.
+    if (date == m_ddmmyy) {
+        return true;
+    }
+    const int64_t YY{static_cast<int64_t>(date % 100)};
+    if (!setDate((80 > YY) ? 2000 + YY : 1900 + YY, static_cast<int64_t>((date / 100) % 100), static_cast<int64_t>(date / 10000))) {
+        return false;
+    }
+    m_ddmmyy = static_cast<uint32_t>(date);
+    return true;
+}
+
+bool GNSSDate::update(const int64_t &milliseconds) noexcept {
+    if (isBeforeMidnight(milliseconds)) {
+        return false;
+    }
+    constexpr int64_t HALF_DAY{12 * 3600 * 1000};
+    if ( (0 <= m_days) && (0 <= m_lastTimeOfDay) && (milliseconds + HALF_DAY < m_lastTimeOfDay) ) {
+        m_days++;
+        m_date = 0;
+        m_ddmmyy = 0;
+    }
+    m_lastTimeOfDay = milliseconds;
+    return true;
+}
+
+bool GNSSDate::isBeforeMidnight(const int64_t &milliseconds) const noexcept {
+    // Only sentences delayed by up to a minute count as late; larger jumps
+    // forward (e.g., after an outage) are taken as they are to not get stuck.
+    constexpr int64_t HALF_DAY{12 * 3600 * 1000};
+    constexpr int64_t DAY{24 * 3600 * 1000};
+    constexpr int64_t MAX_DELAY{60 * 1000};
+    return (0 <= m_lastTimeOfDay) && (milliseconds > m_lastTimeOfDay + HALF_DAY) && (m_lastTimeOfDay + DAY - milliseconds <= MAX_DELAY);
+}
+
+bool GNSSDate::hasDate() const noexcept {
+    return (0 <= m_days);
+}
+
+std::chrono::system_clock::time_point GNSSDate::timePoint(const int64_t &milliseconds) const noexcept {
+    constexpr int64_t DAY{24 * 3600 * 1000};
+    const int64_t DAYS{m_days - (isBeforeMidnight(milliseconds) ? 1 : 0)};
+    return std::chrono::system_clock::time_point{} + std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(DAYS * DAY + milliseconds));
+}
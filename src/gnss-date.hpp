@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GNSS_DATE
+#define GNSS_DATE
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * GNSSDate caches the current UTC day from sentences carrying a date (RMC,
+ * ZDA, NAV-PVT) to turn the time of day of all other sentences into absolute
+ * time points with a few integer operations. The day is advanced when the
+ * time of day jumps back by more than twelve hours, i.e., at midnight; a jump
+ * forward across midnight by up to a minute is a late sentence from the day
+ * before.
+ */
+class GNSSDate {
+   private:
+    GNSSDate(const GNSSDate &) = delete;
+    GNSSDate(GNSSDate &&)      = delete;
+    GNSSDate &operator=(const GNSSDate &) = delete;
+    GNSSDate &operator=(GNSSDate &&) = delete;
+
+   public:
+    GNSSDate() = default;
+
+   public:
+    /**
+     * @param timeOfDay Time of day as hhmmss[.sss].
+     * @param length Length of timeOfDay.
+     * @param milliseconds Parsed milliseconds since midnight.
+     * @return true if timeOfDay could be parsed.
+     */
+    static bool parseTimeOfDay(const char *timeOfDay, const size_t &length, int64_t &milliseconds) noexcept;
+
+    /**
+     * @return Days since 1970-01-01 for the given civil date.
+     */
+    static int64_t daysFromCivil(const int64_t &year, const int64_t &month, const int64_t &day) noexcept;
+
+    /**
+     * @param year Four-digit year.
+     * @param month Month 1-12.
+     * @param day Day 1-31.
+     * @return true if the date is plausible and was taken.
+     */
+    bool setDate(const int64_t &year, const int64_t &month, const int64_t &day) noexcept;
+
+    /**
+     * @param ddmmyy Date as in RMC; years before 80 are in the 21st century.
+     * @param length Length of ddmmyy.
+     * @return true if the date could be parsed and was taken.
+     */
+    bool setDate(const char *ddmmyy, const size_t &length) noexcept;
+
+    /**
+     * Advances the day when the time of day wrapped around midnight.
+     *
+     * @param milliseconds Milliseconds since midnight of the latest epoch.
+     * @return false if the time of day is from before the last midnight; the
+     *         state is kept then and a date of that sentence must not be set.
+     */
+    bool update(const int64_t &milliseconds) noexcept;
+
+    bool hasDate() const noexcept;
+
+    /**
+     * @param milliseconds Milliseconds since midnight of the current day or,
+     *        for late sentences, of the day before.
+     * @return Absolute time point; only meaningful if hasDate().
+     */
+    std::chrono::system_clock::time_point timePoint(const int64_t &milliseconds) const noexcept;
+
+   private:
+    bool isBeforeMidnight(const int64_t &milliseconds) const noexcept;
+
+   private:
+    // Cached date as ddmmyy and yyyymmdd to skip converting unchanged dates.
+    uint32_t m_ddmmyy{0};
+    int64_t m_date{0};
+    // Days since 1970-01-01.
+    int64_t m_days{-1};
+    int64_t m_lastTimeOfDay{-1};
+};
+
+#endif
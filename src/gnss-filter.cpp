@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gnss-filter.hpp"
+
+#include <cmath>
+
+namespace {
+    // Process noise of the constant velocity and constant yaw rate models.
+    constexpr double ACCELERATION_NOISE{2.0};           /*m/s^2*/
+    constexpr double YAW_ACCELERATION_NOISE{1.0};       /*rad/s^2*/
+    // Measurement noise without GST and of speed and heading.
+    constexpr double DEFAULT_POSITION_SIGMA{2.5};       /*m*/
+    constexpr double SPEED_SIGMA{0.2};                  /*m/s*/
+    constexpr double HEADING_SIGMA{0.05};               /*rad*/
+    constexpr double MIN_SPEED{0.1};                    /*m/s to bound the heading variance*/
+    // Gaps after which the filter starts over and the local frame is moved.
+    constexpr double MAX_GAP{5.0};                      /*s*/
+    constexpr double MAX_DISTANCE_TO_REFERENCE{1000.0}; /*m*/
+
+    double wrapAngle(const double &angle) noexcept {
+        return std::remainder(angle, 2.0 * M_PI);
+    }
+}
+
+bool GNSSFilter::predict(const std::chrono::system_clock::time_point &tp) noexcept {
+    const double DT{std::chrono::duration<double>(tp - m_time).count()};
+    if (MAX_GAP < DT) {
+        m_isInitialized = false;
+        return false;
+    }
+    // Measurements from the past are fused at the current time.
+    if (0.0 < DT) {
+        using Matrix = KalmanFilter<NUMBER_OF_STATES>::Matrix;
+        Matrix F{};
+        for (uint32_t i{0}; i < NUMBER_OF_STATES; i++) {
+            F[i][i] = 1.0;
+        }
+        F[EAST][EAST_VELOCITY] = DT;
+        F[NORTH][NORTH_VELOCITY] = DT;
+        F[HEADING][YAW_RATE] = DT;
+
+        // Discrete white noise acceleration per pair of position and rate.
+        Matrix Q{};
+        auto addNoise = [&Q, DT](const uint32_t &position, const uint32_t &rate, const double &sigma) {
+            const double q{sigma * sigma};
+            Q[position][position] = DT * DT * DT / 3.0 * q;
+            Q[position][rate] = DT * DT / 2.0 * q;
+            Q[rate][position] = DT * DT / 2.0 * q;
+            Q[rate][rate] = DT * q;
+        };
+        addNoise(EAST, EAST_VELOCITY, ACCELERATION_NOISE);
+        addNoise(NORTH, NORTH_VELOCITY, ACCELERATION_NOISE);
+        addNoise(HEADING, YAW_RATE, YAW_ACCELERATION_NOISE);
+
+        m_filter.predict(F, Q);
+        m_filter.setState(HEADING, wrapAngle(m_filter.state()[HEADING]));
+        m_time = tp;
+    }
+    return true;
+}
+
+void GNSSFilter::setPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept {
+    const double SIGMA_NORTH{(0.0f < m_sigmaLatitude) ? m_sigmaLatitude : DEFAULT_POSITION_SIGMA};
+    const double SIGMA_EAST{(0.0f < m_sigmaLongitude) ? m_sigmaLongitude : DEFAULT_POSITION_SIGMA};
+    if (!m_isInitialized || !predict(tp)) {
+        m_frame.setReference(latitude, longitude);
+        const double HEADING_VARIANCE{m_hasHeading ? HEADING_SIGMA * HEADING_SIGMA : M_PI * M_PI};
+        m_filter.reset({{0.0, 0.0, 0.0, 0.0, m_hasHeading ? m_lastCourse : 0.0, 0.0}},
+                       {{SIGMA_EAST * SIGMA_EAST, SIGMA_NORTH * SIGMA_NORTH, 100.0, 100.0, HEADING_VARIANCE, 1.0}});
+        m_time = tp;
+        m_isInitialized = true;
+        return;
+    }
+
+    const std::array<double, 2> MEASURED{m_frame.toLocal(latitude, longitude)};
+    m_filter.update(EAST, MEASURED[0] - m_filter.state()[EAST], SIGMA_EAST * SIGMA_EAST);
+    m_filter.update(NORTH, MEASURED[1] - m_filter.state()[NORTH], SIGMA_NORTH * SIGMA_NORTH);
+
+    // Keep the local frame small by moving it to the filtered position.
+    if ( (MAX_DISTANCE_TO_REFERENCE < std::fabs(m_filter.state()[EAST])) || (MAX_DISTANCE_TO_REFERENCE < std::fabs(m_filter.state()[NORTH])) ) {
+        const GNSSFilterState STATE{state()};
+        m_frame.setReference(STATE.latitude, STATE.longitude);
+        m_filter.setState(EAST, 0.0);
+        m_filter.setState(NORTH, 0.0);
+    }
+}
+
+void GNSSFilter::setPositionError(const float &sigmaLatitude, const float &sigmaLongitude) noexcept {
+    m_sigmaLatitude = sigmaLatitude;
+    m_sigmaLongitude = sigmaLongitude;
+}
+
+void GNSSFilter::setSpeed(const float &speed, const std::chrono::system_clock::time_point &tp) noexcept {
+    m_lastSpeed = static_cast<double>(speed);
+    if (!m_isInitialized || !m_hasHeading || !predict(tp)) {
+        return;
+    }
+    // Velocity from speed and the last course; the course error matters
+    // less the slower the vehicle is.
+    const double VARIANCE{SPEED_SIGMA * SPEED_SIGMA + m_lastSpeed * m_lastSpeed * HEADING_SIGMA * HEADING_SIGMA};
+    m_filter.update(EAST_VELOCITY, m_lastSpeed * std::sin(m_lastCourse) - m_filter.state()[EAST_VELOCITY], VARIANCE);
+    m_filter.update(NORTH_VELOCITY, m_lastSpeed * std::cos(m_lastCourse) - m_filter.state()[NORTH_VELOCITY], VARIANCE);
+}
+
+void GNSSFilter::setHeading(const float &heading, const std::chrono::system_clock::time_point &tp) noexcept {
+    m_lastCourse = static_cast<double>(heading);
+    const bool HAD_HEADING{m_hasHeading};
+    m_hasHeading = true;
+    if (!m_isInitialized || !predict(tp)) {
+        return;
+    }
+    if (!HAD_HEADING) {
+        m_filter.setState(HEADING, wrapAngle(m_lastCourse));
+    }
+    // Course over ground becomes noisy at low speed.
+    const double SPEED{std::fmax(m_lastSpeed, MIN_SPEED)};
+    const double VARIANCE{HEADING_SIGMA * HEADING_SIGMA + (SPEED_SIGMA / SPEED) * (SPEED_SIGMA / SPEED)};
+    m_filter.update(HEADING, wrapAngle(m_lastCourse - m_filter.state()[HEADING]), VARIANCE);
+    m_filter.setState(HEADING, wrapAngle(m_filter.state()[HEADING]));
+}
+
+GNSSFilterState GNSSFilter::state() const noexcept {
+    GNSSFilterState s;
+    if (!m_isInitialized) {
+        return s;
+    }
+    const KalmanFilter<NUMBER_OF_STATES>::Vector &X{m_filter.state()};
+    const std::array<double, 2> POSITION{m_frame.toWGS84(X[EAST], X[NORTH])};
+    s.latitude = POSITION[0];
+    s.longitude = POSITION[1];
+    s.groundSpeed = static_cast<float>(std::hypot(X[EAST_VELOCITY], X[NORTH_VELOCITY]));
+    const double YAW{X[HEADING]};
+    s.northHeading = static_cast<float>((0.0 > YAW) ? YAW + 2.0 * M_PI : YAW);
+    s.yawRate = static_cast<float>(X[YAW_RATE]);
+    s.sigmaPosition = static_cast<float>(std::sqrt(std::fmax(m_filter.variance(EAST), m_filter.variance(NORTH))));
+    return s;
+}
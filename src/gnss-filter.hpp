@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GNSS_FILTER
+#define GNSS_FILTER
+
+#include "kalman-filter.hpp"
+#include "local-frame.hpp"
+
+#include <chrono>
+
+/**
+ * Filtered state of GNSSFilter; speed in m/s, heading in radians from true
+ * north, and the position sigma in meters.
+ */
+struct GNSSFilterState {
+    double latitude{0.0};
+    double longitude{0.0};
+    float groundSpeed{0.0f};
+    float northHeading{0.0f};
+    float yawRate{0.0f};
+    float sigmaPosition{0.0f};
+};
+
+/**
+ * GNSSFilter smooths position, velocity, and heading with a Kalman filter
+ * over east, north, their velocities, heading, and yaw rate in a local frame
+ * around a reference position. Positions are weighted by the sigmas from
+ * GST when available; course over ground is weighted less at low speed where
+ * it is dominated by noise.
+ */
+class GNSSFilter {
+   private:
+    GNSSFilter(const GNSSFilter &) = delete;
+    GNSSFilter(GNSSFilter &&)      = delete;
+    GNSSFilter &operator=(const GNSSFilter &) = delete;
+    GNSSFilter &operator=(GNSSFilter &&) = delete;
+
+   public:
+    GNSSFilter() = default;
+
+   public:
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param tp Time point of the position.
+     */
+    void setPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept;
+
+    /**
+     * @param sigmaLatitude Standard deviation of latitude in meters from GST.
+     * @param sigmaLongitude Standard deviation of longitude in meters from GST.
+     */
+    void setPositionError(const float &sigmaLatitude, const float &sigmaLongitude) noexcept;
+
+    /**
+     * @param speed Ground speed in m/s.
+     * @param tp Time point of the speed.
+     */
+    void setSpeed(const float &speed, const std::chrono::system_clock::time_point &tp) noexcept;
+
+    /**
+     * @param heading Heading or course over ground in radians from true north.
+     * @param tp Time point of the heading.
+     */
+    void setHeading(const float &heading, const std::chrono::system_clock::time_point &tp) noexcept;
+
+    bool isInitialized() const noexcept {
+        return m_isInitialized;
+    }
+
+    GNSSFilterState state() const noexcept;
+
+   private:
+    enum States { EAST = 0, NORTH = 1, EAST_VELOCITY = 2, NORTH_VELOCITY = 3, HEADING = 4, YAW_RATE = 5, NUMBER_OF_STATES = 6 };
+
+   private:
+    bool predict(const std::chrono::system_clock::time_point &tp) noexcept;
+
+   private:
+    KalmanFilter<NUMBER_OF_STATES> m_filter{};
+    bool m_isInitialized{false};
+    bool m_hasHeading{false};
+    std::chrono::system_clock::time_point m_time{};
+
+    LocalFrame m_frame{};
+
+    float m_sigmaLatitude{0.0f};
+    float m_sigmaLongitude{0.0f};
+    double m_lastSpeed{0.0};
+    double m_lastCourse{0.0};
+};
+
+#endif
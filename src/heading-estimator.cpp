@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "heading-estimator.hpp"
+
+#include <cmath>
+
+namespace {
+    // Gap after which the fit starts over.
+    constexpr double MAX_GAP{2.0};                      /*s*/
+    // Bounds of the local frame to keep the running sums precise.
+    constexpr double MAX_DISTANCE_TO_REFERENCE{1000.0}; /*m*/
+    constexpr double MAX_TIME_TO_REFERENCE{60.0};       /*s*/
+    constexpr uint32_t MIN_SAMPLES{3};
+}
+
+HeadingEstimator::HeadingEstimator(const double &minSpeed) noexcept
+    : m_minSpeed(minSpeed) {
+}
+
+void HeadingEstimator::reset() noexcept {
+    m_frame.reset();
+    m_count = 0;
+    m_next = 0;
+    m_sumT = m_sumTT = m_sumE = m_sumTE = m_sumN = m_sumTN = 0.0;
+}
+
+void HeadingEstimator::moveReference(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept {
+    // Move the samples in the buffer into the new frame.
+    const double DT{std::chrono::duration<double>(tp - m_referenceTime).count()};
+    const std::array<double, 2> OFFSET{m_frame.toLocal(latitude, longitude)};
+    m_sumT = m_sumTT = m_sumE = m_sumTE = m_sumN = m_sumTN = 0.0;
+    for (uint32_t i{0}; i < m_count; i++) {
+        m_samples[i][TIME] -= DT;
+        m_samples[i][EAST] -= OFFSET[0];
+        m_samples[i][NORTH] -= OFFSET[1];
+        add(m_samples[i], 1.0);
+    }
+    m_frame.setReference(latitude, longitude);
+    m_referenceTime = tp;
+}
+
+void HeadingEstimator::add(const std::array<double, 3> &sample, const double &sign) noexcept {
+    m_sumT += sign * sample[TIME];
+    m_sumTT += sign * sample[TIME] * sample[TIME];
+    m_sumE += sign * sample[EAST];
+    m_sumTE += sign * sample[TIME] * sample[EAST];
+    m_sumN += sign * sample[NORTH];
+    m_sumTN += sign * sample[TIME] * sample[NORTH];
+}
+
+bool HeadingEstimator::update(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp, float &heading) noexcept {
+    double gap{0.0};
+    if (!m_frame.nextEpoch(tp, gap)) {
+        return false;
+    }
+    if ((0.0 > gap) || (MAX_GAP < gap)) {
+        reset();
+    }
+    if (!m_frame.hasReference()) {
+        m_frame.setReference(latitude, longitude);
+        m_referenceTime = tp;
+    }
+
+    const std::array<double, 2> LOCAL{m_frame.toLocal(latitude, longitude)};
+    std::array<double, 3> sample{{std::chrono::duration<double>(tp - m_referenceTime).count(), LOCAL[0], LOCAL[1]}};
+    if ((MAX_TIME_TO_REFERENCE < sample[TIME]) || (MAX_DISTANCE_TO_REFERENCE < std::hypot(sample[EAST], sample[NORTH]))) {
+        moveReference(latitude, longitude, tp);
+        sample = std::array<double, 3>{{0.0, 0.0, 0.0}};
+    }
+
+    if (WINDOW == m_count) {
+        add(m_samples[m_next], -1.0);
+    }
+    else {
+        m_count++;
+    }
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % WINDOW;
+    add(sample, 1.0);
+
+    if (MIN_SAMPLES > m_count) {
+        return false;
+    }
+    const double N{static_cast<double>(m_count)};
+    const double DENOMINATOR{N * m_sumTT - m_sumT * m_sumT};
+    if (!(0.0 < DENOMINATOR)) {
+        return false;
+    }
+    const double EAST_VELOCITY{(N * m_sumTE - m_sumT * m_sumE) / DENOMINATOR};
+    const double NORTH_VELOCITY{(N * m_sumTN - m_sumT * m_sumN) / DENOMINATOR};
+    if (m_minSpeed > std::hypot(EAST_VELOCITY, NORTH_VELOCITY)) {
+        return false;
+    }
+    const double HEADING{std::atan2(EAST_VELOCITY, NORTH_VELOCITY)};
+    heading = static_cast<float>((0.0 > HEADING) ? HEADING + 2.0 * M_PI : HEADING);
+    return true;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HEADING_ESTIMATOR
+#define HEADING_ESTIMATOR
+
+#include "local-frame.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * HeadingEstimator derives the heading from consecutive positions for units
+ * that do not report the course over ground. East and north over time are
+ * fitted with a straight line by least squares over the last positions in a
+ * local frame; the running sums of the fit are updated in constant time per
+ * position. No heading is estimated below the given speed where the positions
+ * are dominated by noise.
+ */
+class HeadingEstimator {
+   private:
+    HeadingEstimator(const HeadingEstimator &) = delete;
+    HeadingEstimator(HeadingEstimator &&)      = delete;
+    HeadingEstimator &operator=(const HeadingEstimator &) = delete;
+    HeadingEstimator &operator=(HeadingEstimator &&) = delete;
+
+   public:
+    /**
+     * @param minSpeed Speed in m/s from which on a heading is estimated.
+     */
+    explicit HeadingEstimator(const double &minSpeed = 1.0) noexcept;
+
+   public:
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param tp Time point of the position.
+     * @param heading Estimated heading in radians from true north [0, 2pi).
+     * @return true if a heading was estimated.
+     */
+    bool update(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp, float &heading) noexcept;
+
+   private:
+    enum : uint32_t { WINDOW = 5 };
+    enum Samples { TIME = 0, EAST = 1, NORTH = 2 };
+
+   private:
+    void reset() noexcept;
+    void moveReference(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept;
+    void add(const std::array<double, 3> &sample, const double &sign) noexcept;
+
+   private:
+    const double m_minSpeed;
+
+    LocalFrame m_frame{};
+    std::chrono::system_clock::time_point m_referenceTime{};
+
+    // Ring buffer of seconds, east, and north relative to the reference.
+    std::array<std::array<double, 3>, WINDOW> m_samples{};
+    uint32_t m_count{0};
+    uint32_t m_next{0};
+
+    double m_sumT{0.0};
+    double m_sumTT{0.0};
+    double m_sumE{0.0};
+    double m_sumTE{0.0};
+    double m_sumN{0.0};
+    double m_sumTN{0.0};
+};
+
+#endif
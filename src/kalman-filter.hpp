@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KALMAN_FILTER
+#define KALMAN_FILTER
+
+#include <array>
+#include <cstddef>
+
+/**
+ * KalmanFilter with N states in statically sized arrays. Measurements are
+ * fused one at a time and each observes a single state directly, which
+ * avoids matrix inversions; uncorrelated measurements of several states are
+ * fused by calling update for each of them.
+ */
+template <std::size_t N>
+class KalmanFilter {
+   private:
+    KalmanFilter(const KalmanFilter &) = delete;
+    KalmanFilter(KalmanFilter &&)      = delete;
+    KalmanFilter &operator=(const KalmanFilter &) = delete;
+    KalmanFilter &operator=(KalmanFilter &&) = delete;
+
+   public:
+    using Vector = std::array<double, N>;
+    using Matrix = std::array<std::array<double, N>, N>;
+
+   public:
+    KalmanFilter() = default;
+
+   public:
+    /**
+     * @param x Initial state.
+     * @param variances Initial variances of the states, which are uncorrelated.
+     */
+    void reset(const Vector &x, const Vector &variances) noexcept {
+        m_x = x;
+        for (std::size_t i{0}; i < N; i++) {
+            m_P[i].fill(0.0);
+            m_P[i][i] = variances[i];
+        }
+    }
+
+    /**
+     * Propagates the state with x = F * x and P = F * P * F^T + Q.
+     */
+    void predict(const Matrix &F, const Matrix &Q) noexcept {
+        Vector x{};
+        Matrix FP{};
+        for (std::size_t i{0}; i < N; i++) {
+            for (std::size_t k{0}; k < N; k++) {
+                x[i] += F[i][k] * m_x[k];
+                for (std::size_t j{0}; j < N; j++) {
+                    FP[i][j] += F[i][k] * m_P[k][j];
+                }
+            }
+        }
+        m_x = x;
+        for (std::size_t i{0}; i < N; i++) {
+            for (std::size_t j{0}; j < N; j++) {
+                double sum{Q[i][j]};
+                for (std::size_t k{0}; k < N; k++) {
+                    sum += FP[i][k] * F[j][k];
+                }
+                m_P[i][j] = sum;
+            }
+        }
+    }
+
+    /**
+     * Fuses a measurement of state i.
+     * @param innovation Measurement minus state i, e.g., wrapped for angles.
+     * @param variance Variance of the measurement.
+     */
+    void update(const std::size_t &i, const double &innovation, const double &variance) noexcept {
+        const double S{m_P[i][i] + variance};
+        if (0.0 >= S) {
+            return;
+        }
+        const Vector ROW(m_P[i]);
+        for (std::size_t j{0}; j < N; j++) {
+            const double K{ROW[j] / S};
+            m_x[j] += K * innovation;
+            for (std::size_t k{0}; k < N; k++) {
+                m_P[j][k] -= K * ROW[k];
+            }
+        }
+    }
+
+    const Vector &state() const noexcept {
+        return m_x;
+    }
+
+    void setState(const std::size_t &i, const double &value) noexcept {
+        m_x[i] = value;
+    }
+
+    double variance(const std::size_t &i) const noexcept {
+        return m_P[i][i];
+    }
+
+   private:
+    Vector m_x{};
+    Matrix m_P{};
+};
+
+#endif
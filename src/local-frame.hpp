@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCAL_FRAME
+#define LOCAL_FRAME
+
+#include "wgs84.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+
+/**
+ * LocalFrame maps positions into meters east and north of a reference
+ * position with the meters per degree of the reference latitude, which is
+ * accurate to well below 0.1% within a few kilometers. Moving the reference
+ * by less than 0.01 degrees in latitude keeps the scale factors, which then
+ * change by less than 0.03%, so that no trigonometric functions are evaluated
+ * per position. The frame also keeps track of the epochs of the positions
+ * fed into a stage.
+ */
+class LocalFrame {
+   private:
+    LocalFrame(const LocalFrame &) = delete;
+    LocalFrame(LocalFrame &&)      = delete;
+    LocalFrame &operator=(const LocalFrame &) = delete;
+    LocalFrame &operator=(LocalFrame &&) = delete;
+
+   public:
+    LocalFrame() = default;
+
+   public:
+    /**
+     * @param latitude Latitude of the reference in degrees.
+     * @param longitude Longitude of the reference in degrees.
+     */
+    void setReference(const double &latitude, const double &longitude) noexcept {
+        constexpr double MAX_SCALE_LATITUDE_CHANGE{0.01};
+        if (!m_hasReference || (MAX_SCALE_LATITUDE_CHANGE < std::fabs(latitude - m_scaleLatitude))) {
+            m_metersPerDegree = WGS84::metersPerDegree(latitude);
+            m_scaleLatitude = latitude;
+        }
+        m_latitude = latitude;
+        m_longitude = longitude;
+        m_hasReference = true;
+    }
+
+    /**
+     * Drops the reference; the last epoch is kept.
+     */
+    void reset() noexcept {
+        m_hasReference = false;
+    }
+
+    bool hasReference() const noexcept {
+        return m_hasReference;
+    }
+
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @return East and north in meters of the reference; the longitude is
+     *         unwrapped across the antimeridian.
+     */
+    std::array<double, 2> toLocal(const double &latitude, const double &longitude) const noexcept {
+        return std::array<double, 2>{{std::remainder(longitude - m_longitude, 360.0) * m_metersPerDegree[1],
+                                      (latitude - m_latitude) * m_metersPerDegree[0]}};
+    }
+
+    /**
+     * @param east Meters east of the reference.
+     * @param north Meters north of the reference.
+     * @return Latitude and longitude in degrees.
+     */
+    std::array<double, 2> toWGS84(const double &east, const double &north) const noexcept {
+        return std::array<double, 2>{{m_latitude + north / m_metersPerDegree[0],
+                                      std::remainder(m_longitude + east / m_metersPerDegree[1], 360.0)}};
+    }
+
+    /**
+     * GGA, RMC, and PTNL,GGK all report the position of an epoch, so a stage
+     * fed with every position sees the same epoch several times.
+     *
+     * @param tp Time point of a position.
+     * @param gap Seconds since the last epoch; 0 for the first one.
+     * @return false if the position belongs to the last epoch.
+     */
+    bool nextEpoch(const std::chrono::system_clock::time_point &tp, double &gap) noexcept {
+        if (m_hasEpoch && (m_epoch == tp)) {
+            return false;
+        }
+        gap = m_hasEpoch ? std::chrono::duration<double>(tp - m_epoch).count() : 0.0;
+        m_epoch = tp;
+        m_hasEpoch = true;
+        return true;
+    }
+
+   private:
+    bool m_hasReference{false};
+    double m_latitude{0.0};
+    double m_longitude{0.0};
+    double m_scaleLatitude{0.0};
+    // Meters per degree of latitude and of longitude.
+    std::array<double, 2> m_metersPerDegree{{0.0, 0.0}};
+
+    bool m_hasEpoch{false};
+    std::chrono::system_clock::time_point m_epoch{};
+};
+
+#endif
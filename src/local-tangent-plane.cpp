@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "local-tangent-plane.hpp"
+#include "wgs84.hpp"
+
+#include <cmath>
+
+namespace {
+    constexpr double DEG2RAD{M_PI / 180.0};
+    // Beyond this difference to the origin (about 110 km), the series for
+    // the difference angle is replaced by the library functions.
+    constexpr double MAX_SERIES_ANGLE{1.0 * DEG2RAD};
+
+    // Sine and cosine of the sum a + d from those of a; d is small.
+    void sinCosOfSum(const double &sinA, const double &cosA, const double &d, double &sinSum, double &cosSum) noexcept {
+        double sinD{0.0};
+        double cosD{1.0};
+        if (MAX_SERIES_ANGLE >= std::fabs(d)) {
+            // Truncation error below 1e-16 for |d| <= 1 degree.
+            const double D2{d * d};
+            sinD = d * (1.0 - D2 / 6.0 * (1.0 - D2 / 20.0 * (1.0 - D2 / 42.0)));
+            cosD = 1.0 - D2 / 2.0 * (1.0 - D2 / 12.0 * (1.0 - D2 / 30.0 * (1.0 - D2 / 56.0)));
+        }
+        else {
+            sinD = std::sin(d);
+            cosD = std::cos(d);
+        }
+        sinSum = sinA * cosD + cosA * sinD;
+        cosSum = cosA * cosD - sinA * sinD;
+    }
+
+    std::array<double, 3> toECEF(const double &sinLatitude, const double &cosLatitude, const double &sinLongitude, const double &cosLongitude, const double &altitude) noexcept {
+        const double N{WGS84::A / std::sqrt(1.0 - WGS84::E2 * sinLatitude * sinLatitude)};
+        return std::array<double, 3>{{(N + altitude) * cosLatitude * cosLongitude,
+                                      (N + altitude) * cosLatitude * sinLongitude,
+                                      (N * (1.0 - WGS84::E2) + altitude) * sinLatitude}};
+    }
+}
+
+void LocalTangentPlane::setOrigin(const double &latitude, const double &longitude, const double &altitude) noexcept {
+    m_origin = {{latitude, longitude, altitude}};
+    m_latitude = latitude * DEG2RAD;
+    m_longitude = longitude * DEG2RAD;
+    m_sinLatitude = std::sin(m_latitude);
+    m_cosLatitude = std::cos(m_latitude);
+    m_sinLongitude = std::sin(m_longitude);
+    m_cosLongitude = std::cos(m_longitude);
+    m_ecef = toECEF(m_sinLatitude, m_cosLatitude, m_sinLongitude, m_cosLongitude, altitude);
+    m_hasOrigin = true;
+}
+
+std::array<double, 3> LocalTangentPlane::toENU(const double &latitude, const double &longitude, const double &altitude) const noexcept {
+    double sinLatitude{0.0};
+    double cosLatitude{1.0};
+    sinCosOfSum(m_sinLatitude, m_cosLatitude, latitude * DEG2RAD - m_latitude, sinLatitude, cosLatitude);
+
+    // Keep the difference in longitude small across the antimeridian.
+    double deltaLongitude{longitude * DEG2RAD - m_longitude};
+    if (M_PI < deltaLongitude) {
+        deltaLongitude -= 2.0 * M_PI;
+    }
+    else if (-M_PI > deltaLongitude) {
+        deltaLongitude += 2.0 * M_PI;
+    }
+    double sinLongitude{0.0};
+    double cosLongitude{1.0};
+    sinCosOfSum(m_sinLongitude, m_cosLongitude, deltaLongitude, sinLongitude, cosLongitude);
+
+    const std::array<double, 3> ECEF{toECEF(sinLatitude, cosLatitude, sinLongitude, cosLongitude, altitude)};
+    const double DX{ECEF[0] - m_ecef[0]};
+    const double DY{ECEF[1] - m_ecef[1]};
+    const double DZ{ECEF[2] - m_ecef[2]};
+    const double T{m_cosLongitude * DX + m_sinLongitude * DY};
+    return std::array<double, 3>{{-m_sinLongitude * DX + m_cosLongitude * DY,
+                                  -m_sinLatitude * T + m_cosLatitude * DZ,
+                                  m_cosLatitude * T + m_sinLatitude * DZ}};
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCAL_TANGENT_PLANE
+#define LOCAL_TANGENT_PLANE
+
+#include <array>
+
+/**
+ * LocalTangentPlane converts WGS84 positions into east, north, and up in
+ * meters around an origin. The trigonometric terms of the origin and its
+ * ECEF position are computed once when the origin is set; per position, the
+ * sine and cosine of latitude and longitude are derived from the cached ones
+ * by the angle sum identities with a short series for the small difference,
+ * followed by a rotation of the ECEF difference.
+ */
+class LocalTangentPlane {
+   private:
+    LocalTangentPlane(const LocalTangentPlane &) = delete;
+    LocalTangentPlane(LocalTangentPlane &&)      = delete;
+    LocalTangentPlane &operator=(const LocalTangentPlane &) = delete;
+    LocalTangentPlane &operator=(LocalTangentPlane &&) = delete;
+
+   public:
+    LocalTangentPlane() = default;
+
+   public:
+    /**
+     * @param latitude Latitude of the origin in degrees.
+     * @param longitude Longitude of the origin in degrees.
+     * @param altitude Ellipsoidal height of the origin in meters.
+     */
+    void setOrigin(const double &latitude, const double &longitude, const double &altitude) noexcept;
+
+    bool hasOrigin() const noexcept {
+        return m_hasOrigin;
+    }
+
+    const std::array<double, 3> &origin() const noexcept {
+        return m_origin;
+    }
+
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param altitude Ellipsoidal height in meters.
+     * @return East, north, and up in meters relative to the origin.
+     */
+    std::array<double, 3> toENU(const double &latitude, const double &longitude, const double &altitude) const noexcept;
+
+   private:
+    bool m_hasOrigin{false};
+    std::array<double, 3> m_origin{};
+    double m_latitude{0.0};
+    double m_longitude{0.0};
+    double m_sinLatitude{0.0};
+    double m_cosLatitude{1.0};
+    double m_sinLongitude{0.0};
+    double m_cosLongitude{1.0};
+    std::array<double, 3> m_ecef{};
+};
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "motion-gate.hpp"
+
+#include <cmath>
+
+MotionGate::MotionGate(const double &margin, const double &maxAcceleration, const uint32_t &maxConsecutiveRejections) noexcept
+    : m_margin(margin)
+    , m_maxAcceleration(maxAcceleration)
+    , m_maxConsecutiveRejections(maxConsecutiveRejections) {
+}
+
+void MotionGate::setSpeed(const float &speed) noexcept {
+    m_speed = static_cast<double>(speed);
+}
+
+bool MotionGate::accept(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept {
+    if (!m_frame.hasReference() || (m_maxConsecutiveRejections <= m_consecutiveRejections)) {
+        acceptPosition(latitude, longitude, tp);
+        return true;
+    }
+
+    const double DT{std::fmax(std::chrono::duration<double>(tp - m_time).count(), 0.0)};
+    const double SPEED{std::fmax(m_speed, m_speedAtPosition)};
+    const double MAX_DISTANCE{m_margin + SPEED * DT + 0.5 * m_maxAcceleration * DT * DT};
+    const std::array<double, 2> LOCAL{m_frame.toLocal(latitude, longitude)};
+    if (MAX_DISTANCE * MAX_DISTANCE < LOCAL[0] * LOCAL[0] + LOCAL[1] * LOCAL[1]) {
+        m_consecutiveRejections++;
+        m_rejectedPositions.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    acceptPosition(latitude, longitude, tp);
+    return true;
+}
+
+void MotionGate::acceptPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept {
+    m_frame.setReference(latitude, longitude);
+    m_time = tp;
+    m_speedAtPosition = m_speed;
+    m_consecutiveRejections = 0;
+    m_acceptedPositions.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOTION_GATE
+#define MOTION_GATE
+
+#include "local-frame.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * MotionGate rejects positions that the vehicle could not have reached from
+ * the last accepted one given the reported ground speed, a maximum
+ * acceleration, and a margin for the noise of the receiver, e.g., jumps from
+ * multipath. Distances are computed in a local frame with meters per degree
+ * cached for the latitude of the last accepted position. After a number of
+ * consecutive rejections, the next position is accepted to recover from an
+ * outlier that was accepted as the first position.
+ */
+class MotionGate {
+   private:
+    MotionGate(const MotionGate &) = delete;
+    MotionGate(MotionGate &&)      = delete;
+    MotionGate &operator=(const MotionGate &) = delete;
+    MotionGate &operator=(MotionGate &&) = delete;
+
+   public:
+    /**
+     * @param margin Distance in meters always accepted between two positions.
+     * @param maxAcceleration Acceleration in m/s^2 beyond the reported speed.
+     * @param maxConsecutiveRejections Rejections after which the next position is accepted.
+     */
+    explicit MotionGate(const double &margin = 10.0, const double &maxAcceleration = 5.0, const uint32_t &maxConsecutiveRejections = 10) noexcept;
+
+   public:
+    /**
+     * @param speed Ground speed in m/s.
+     */
+    void setSpeed(const float &speed) noexcept;
+
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param tp Time point of the position.
+     * @return true if the position is consistent with the motion.
+     */
+    bool accept(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept;
+
+    uint64_t acceptedPositions() const noexcept {
+        return m_acceptedPositions.load(std::memory_order_relaxed);
+    }
+
+    uint64_t rejectedPositions() const noexcept {
+        return m_rejectedPositions.load(std::memory_order_relaxed);
+    }
+
+   private:
+    void acceptPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept;
+
+   private:
+    const double m_margin;
+    const double m_maxAcceleration;
+    const uint32_t m_maxConsecutiveRejections;
+
+    // Local frame around the last accepted position.
+    LocalFrame m_frame{};
+    std::chrono::system_clock::time_point m_time{};
+    double m_speedAtPosition{0.0};
+    double m_speed{0.0};
+    uint32_t m_consecutiveRejections{0};
+
+    std::atomic<uint64_t> m_acceptedPositions{0};
+    std::atomic<uint64_t> m_rejectedPositions{0};
+};
+
+#endif
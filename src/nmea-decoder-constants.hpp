@@ -24,6 +24,10 @@ enum NMEADecoderConstants {
     UNKNOWN     = 0,
     BUFFER_SIZE = 2048,
     HEADER_SIZE = 6,    /*$--XYZ*/
+    HEADING_SOURCE_TIMEOUT = 1500, /*ms until a lower-priority heading source is used again*/
+    MAX_SENTENCE_LENGTH = 160,     /*NMEA allows 82 bytes; proprietary sentences are longer*/
+    MAX_UBX_FRAME_LENGTH = 100,    /*incomplete UBX frames are only waited for up to the length of NAV-PVT, the only decoded one; longer frames are skipped if complete and discarded as noise otherwise*/
+    MIN_SPEED_FOR_COURSE = 500,    /*mm/s below which NAV-PVT's heading of motion is not used*/
 };
 
 #endif
@@ -15,14 +15,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "cluon-complete.hpp"
 #include "nmea-decoder.hpp"
 #include "nmea-decoder-constants.hpp"
+#include "rtcm3-frame.hpp"
+#include "ubx-frame.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <string>
 
+// Incomplete NAV-PVT frames must be waited for to be reassembled.
+static_assert(UBXFrame::HEADER_SIZE + UBXFrame::NAV_PVT_LENGTH + UBXFrame::CHECKSUM_SIZE <= NMEADecoderConstants::MAX_UBX_FRAME_LENGTH, "MAX_UBX_FRAME_LENGTH below NAV-PVT");
+
 NMEADecoder::NMEADecoder(
     std::function<void(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp)> delegateLatitudeLongitude,
     std::function<void(const float &heading, const std::chrono::system_clock::time_point &tp)> delegateHeading,
@@ -44,125 +49,754 @@ void NMEADecoder::decode(const std::string &data, std::chrono::system_clock::tim
     size_t bytesCopied{0};
     while (bytesCopied != bytesAvailable) {
       // How many bytes can we store in our buffer?
-      size_t bytesToCopy{((NMEADecoderConstants::BUFFER_SIZE - m_size) < bytesAvailable) ? (NMEADecoderConstants::BUFFER_SIZE - m_size) : bytesAvailable};
-      std::memcpy(m_buffer+m_size, data.data(), bytesToCopy);
+      const size_t bytesToCopy{std::min(NMEADecoderConstants::BUFFER_SIZE - m_size, bytesAvailable - bytesCopied)};
+      std::memcpy(m_buffer + m_size, data.data() + bytesCopied, bytesToCopy);
       // Store how much we copied.
       bytesCopied += bytesToCopy;
       // Booking for the m_buffer fill level.
       m_size += bytesToCopy;
       // Consume data from m_buffer.
-      size_t consumed = parseBuffer(m_buffer, m_size, std::move(tp));
-      // Discard processed entries.
-      for (size_t i{0}; (0 < consumed) && (i < (m_size - consumed)); i++) {
-          m_buffer[i] = m_buffer[i + consumed];
+      size_t consumed = parseBuffer(m_buffer, m_size, std::chrono::system_clock::time_point{tp});
+      // Sentences and frames are shorter than the buffer; if it is full
+      // nevertheless, discard its content to guarantee progress.
+      if ((0 == consumed) && (NMEADecoderConstants::BUFFER_SIZE == m_size)) {
+          m_discardedBytes.fetch_add(m_size, std::memory_order_relaxed);
+          m_sentence.scanned = 0;
+          consumed = m_size;
       }
+      // Discard processed entries.
+      std::memmove(m_buffer, m_buffer + consumed, m_size - consumed);
       m_size -= consumed;
-      // If the parser does not work at all, cancel it.
-      if (m_size >= NMEADecoderConstants::BUFFER_SIZE) {
-          break;
-      }
     }
 }
 
-size_t NMEADecoder::parseBuffer(const uint8_t *buffer, const size_t size, std::chrono::system_clock::time_point &&tp) {
-    auto findCRLF = [](const uint8_t *_buffer, const size_t _offset, const size_t _size){
-        size_t length{0};
-        for(size_t i{0}; (_offset + NMEADecoderConstants::HEADER_SIZE + i + 1) < _size; i++) {
-            if ( ( ('\r' == _buffer[_offset + NMEADecoderConstants::HEADER_SIZE + i]) &&
-                   ('\n' == _buffer[_offset + NMEADecoderConstants::HEADER_SIZE + i + 1]) ) ||
-                   ('\n' == _buffer[_offset + NMEADecoderConstants::HEADER_SIZE + i]) ) {
-                length = NMEADecoderConstants::HEADER_SIZE + i + 1;
-                break;
-            }
-        }
-        return length;
-    };
+void NMEADecoder::useGNSSTime(const bool &enabled) noexcept {
+    m_useGNSSTime = enabled;
+}
 
+uint64_t NMEADecoder::discardedBytes() const noexcept {
+    return m_discardedBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t NMEADecoder::truncatedSentences() const noexcept {
+    return m_truncatedSentences.load(std::memory_order_relaxed);
+}
+
+uint64_t NMEADecoder::invalidChecksums() const noexcept {
+    return m_invalidChecksums.load(std::memory_order_relaxed);
+}
+
+void NMEADecoder::setDelegateAltitude(std::function<void(const float &altitude, const std::chrono::system_clock::time_point &tp)> delegateAltitude) noexcept {
+    m_delegateAltitude = std::move(delegateAltitude);
+}
+
+void NMEADecoder::setDelegateFixQuality(std::function<void(const NMEAFixQuality &quality, const std::chrono::system_clock::time_point &tp)> delegateFixQuality) noexcept {
+    m_delegateFixQuality = std::move(delegateFixQuality);
+}
+
+void NMEADecoder::setDelegatePositionError(std::function<void(const NMEAPositionError &error, const std::chrono::system_clock::time_point &tp)> delegatePositionError) noexcept {
+    m_delegatePositionError = std::move(delegatePositionError);
+}
+
+void NMEADecoder::setDelegateEpoch(std::function<void(const NMEAEpoch &epoch, const std::chrono::system_clock::time_point &tp)> delegateEpoch) noexcept {
+    m_delegateEpoch = std::move(delegateEpoch);
+}
+
+void NMEADecoder::setDelegateDilution(std::function<void(const NMEADilution &dilution, const std::chrono::system_clock::time_point &tp)> delegateDilution) noexcept {
+    m_delegateDilution = std::move(delegateDilution);
+}
+
+void NMEADecoder::setDelegateAttitude(std::function<void(const NMEAAttitude &attitude, const std::chrono::system_clock::time_point &tp)> delegateAttitude) noexcept {
+    m_delegateAttitude = std::move(delegateAttitude);
+}
+
+void NMEADecoder::setDelegateSatellites(std::function<void(const SatelliteTable &table, const SatelliteTable::Constellation &constellation, const std::chrono::system_clock::time_point &tp)> delegateSatellites) noexcept {
+    m_delegateSatellites = std::move(delegateSatellites);
+}
+
+void NMEADecoder::setDelegateRTCM3Frame(std::function<void(const char *frame, const size_t &length, const std::chrono::system_clock::time_point &tp)> delegateRTCM3Frame) noexcept {
+    m_delegateRTCM3Frame = std::move(delegateRTCM3Frame);
+}
+
+void NMEADecoder::setDelegateRawSentence(std::function<void(const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &tp)> delegateRawSentence) noexcept {
+    m_delegateRawSentence = std::move(delegateRawSentence);
+}
+
+std::chrono::system_clock::time_point NMEADecoder::sampleTime(const char *timeOfDay, const size_t &timeOfDayLength, const char *date, const size_t &dateLength, const std::chrono::system_clock::time_point &arrival) noexcept {
+    int64_t milliseconds{0};
+    const bool NEEDS_TIME_OF_DAY{m_useGNSSTime || (nullptr != m_delegateEpoch)};
+    if (!NEEDS_TIME_OF_DAY || !GNSSDate::parseTimeOfDay(timeOfDay, timeOfDayLength, milliseconds)) {
+        return arrival;
+    }
+    beginEpoch(milliseconds);
+    if (!m_useGNSSTime) {
+        return arrival;
+    }
+    // Sentences without date crossing midnight advance the cached date.
+    if (m_gnssDate.update(milliseconds)) {
+        m_gnssDate.setDate(date, dateLength);
+    }
+    return (m_gnssDate.hasDate() ? m_gnssDate.timePoint(milliseconds) : arrival);
+}
+
+void NMEADecoder::beginEpoch(const int64_t &timeOfDay) noexcept {
+    if ( (nullptr == m_delegateEpoch) || (timeOfDay == m_epochTimeOfDay) ) {
+        return;
+    }
+    // The first sentence with a new time of day completes the previous epoch.
+    if (m_epochHasPosition) {
+        m_delegateEpoch(m_epoch, m_epochTime);
+    }
+    m_epoch = NMEAEpoch{};
+    m_epochHasPosition = false;
+    m_epochTimeOfDay = timeOfDay;
+}
+
+void NMEADecoder::setEpochPosition(const int64_t &latitude, const int64_t &longitude, const std::chrono::system_clock::time_point &tp) noexcept {
+    if (nullptr != m_delegateEpoch) {
+        m_epoch.latitude = toDegrees(latitude);
+        m_epoch.longitude = toDegrees(longitude);
+        m_epochHasPosition = true;
+        m_epochTime = tp;
+    }
+}
+
+std::chrono::system_clock::time_point NMEADecoder::epochTime(const std::chrono::system_clock::time_point &arrival) const noexcept {
+    const bool HAS_EPOCH{m_useGNSSTime && (std::chrono::system_clock::time_point() != m_lastSampleTime)};
+    return (HAS_EPOCH ? m_lastSampleTime : arrival);
+}
+
+bool NMEADecoder::isBestHeadingSource(const HeadingSource &source, const std::chrono::system_clock::time_point &arrival) noexcept {
+    m_lastHeading[source] = arrival;
+    // Any better source that was seen recently is preferred.
+    const std::chrono::milliseconds TIMEOUT{NMEADecoderConstants::HEADING_SOURCE_TIMEOUT};
+    bool isBest{true};
+    for (size_t i{source + 1U}; i < HeadingSource::NUMBER_OF_HEADING_SOURCES; i++) {
+        const bool isRecent{(std::chrono::system_clock::time_point() != m_lastHeading[i]) &&
+                            (arrival >= m_lastHeading[i]) &&
+                            ((arrival - m_lastHeading[i]) <= TIMEOUT)};
+        isBest &= !isRecent;
+    }
+    return isBest;
+}
+
+size_t NMEADecoder::parseBuffer(const uint8_t *buffer, const size_t size, std::chrono::system_clock::time_point &&tp) {
     const std::chrono::system_clock::time_point timestamp{std::move(tp)};
     size_t offset{0};
+    // Counted locally and published once per call to keep atomic
+    // read-modify-writes out of the loop.
+    uint64_t discardedBytes{0};
+    uint64_t truncatedSentences{0};
+    uint64_t invalidChecksums{0};
     while (true) {
         // Sanity check whether we consumed all data.
         if ((offset + NMEADecoderConstants::HEADER_SIZE) > size) {
-            return offset;
+            break;
         }
 
-        if ( ('G' == buffer[offset + 3]) &&
-             ('G' == buffer[offset + 4]) &&
-             ('A' == buffer[offset + 5]) ) {
-            // Search for CRLF to determine payload length.
-            size_t length{findCRLF(buffer, offset, size)};
-            if (0 == length) {
-                // CRLF not found; need more data.
-                return offset;
+        if (RTCM3Frame::isSync(buffer + offset, size - offset)) {
+            // Skip RTCM3 corrections multiplexed into the stream as a whole.
+            const size_t LENGTH{RTCM3Frame::length(buffer + offset)};
+            const bool IS_COMPLETE{(offset + LENGTH) <= size};
+            if (!IS_COMPLETE && !containsSentence(buffer + offset + 1, size - offset - 1)) {
+                // Frame not complete; need more data.
+                break;
             }
-            // Found CRLF; decode message.
-            {
-                std::string nmeaMessage(reinterpret_cast<char*>(m_buffer+offset), length);
-                auto fields = stringtoolbox::split(nmeaMessage, ',');
-                if (5 < fields.size()) {
-                    double latitude = std::stod(fields[2]) / 100.0;
-                    double longitude = std::stod(fields[4]) / 100.0;
-
-                    latitude = static_cast<int32_t>(latitude) + (latitude - static_cast<int32_t>(latitude)) * 100.0 / 60.0;
-                    longitude = static_cast<int32_t>(longitude) + (longitude - static_cast<int32_t>(longitude)) * 100.0 / 60.0;
-
-                    latitude *= ("S" == fields[3] ? -1.0 : 1.0);
-                    longitude *= ("W" == fields[5] ? -1.0 : 1.0);
-
-                    if (nullptr != m_delegateLatitudeLongitude) {
-                        m_delegateLatitudeLongitude(latitude, longitude, timestamp);
-                    }
-                }
+            // A complete sentence with valid checksum where the rest of the
+            // frame is expected reveals a stray preamble in noise.
+            if (!IS_COMPLETE || !RTCM3Frame::isValid(buffer + offset, LENGTH)) {
+                discardedBytes++;
+                offset++;
+                continue;
+            }
+            if (nullptr != m_delegateRTCM3Frame) {
+                m_delegateRTCM3Frame(reinterpret_cast<const char*>(buffer + offset), LENGTH, timestamp);
+            }
+            offset += LENGTH;
+            continue;
+        }
+
+        if (UBXFrame::isSync(buffer + offset, size - offset)) {
+            const size_t LENGTH{UBXFrame::length(buffer + offset)};
+            const bool IS_COMPLETE{(offset + LENGTH) <= size};
+            if (!IS_COMPLETE && (NMEADecoderConstants::MAX_UBX_FRAME_LENGTH >= LENGTH)) {
+                // Frame not complete; need more data.
+                break;
+            }
+            // Waiting for longer frames would delay all sentences behind a
+            // stray sync in noise; such frames are only skipped if complete.
+            if (!IS_COMPLETE || !UBXFrame::isValid(buffer + offset, LENGTH)) {
+                discardedBytes++;
+                offset++;
+                continue;
+            }
+            if ( (UBXFrame::CLASS_NAV == buffer[offset + 2]) &&
+                 (UBXFrame::ID_NAV_PVT == buffer[offset + 3]) &&
+                 (UBXFrame::HEADER_SIZE + UBXFrame::NAV_PVT_LENGTH + UBXFrame::CHECKSUM_SIZE == LENGTH) ) {
+                decodeNAVPVT(buffer + offset + UBXFrame::HEADER_SIZE, timestamp);
             }
-            offset += length;
-        }
-        else if ( ('R' == buffer[offset + 3]) &&
-                  ('M' == buffer[offset + 4]) &&
-                  ('C' == buffer[offset + 5]) ) {
-            // Search for CRLF to determine payload length.
-            size_t length{findCRLF(buffer, offset, size)};
-            if (0 == length) {
-                // CRLF not found; need more data.
-                return offset;
+            offset += LENGTH;
+            continue;
+        }
+
+        if ('$' != buffer[offset]) {
+            // Skip noise up to the next possible start of a sentence or frame.
+            const size_t SKIPPED{1 + findStart(buffer + offset + 1, size - offset - 1)};
+            discardedBytes += SKIPPED;
+            offset += SKIPPED;
+            continue;
+        }
+
+        // Resume the sentence where the previous call stopped so that each
+        // byte is only scanned once however fragmented the stream is.
+        const size_t END{scanSentence(buffer + offset, size - offset)};
+        if (0 == END) {
+            // Sentence not complete; need more data.
+            break;
+        }
+        if (!m_sentence.isComplete) {
+            // Sentence interrupted by a new '$' or a non-printable character, or too long.
+            discardedBytes += END;
+            truncatedSentences++;
+            offset += END;
+            continue;
+        }
+        // The checksum is optional, but corrupted fields must not be decoded.
+        if (m_sentence.hasChecksum && !m_sentence.hasValidChecksum()) {
+            discardedBytes += END;
+            invalidChecksums++;
+            offset += END;
+            continue;
+        }
+
+        const NMEASentence SENTENCE{sentence(m_fields)};
+        if ( (nullptr != m_delegateRawSentence) && m_sentence.hasValidChecksum() ) {
+            m_delegateRawSentence(reinterpret_cast<const char*>(buffer + offset), END, timestamp);
+        }
+
+        switch (SENTENCE) {
+            case NMEASentence::GGA: decodeGGA(m_fields, timestamp); break;
+            case NMEASentence::RMC: decodeRMC(m_fields, timestamp); break;
+            case NMEASentence::GSA: decodeGSA(m_fields, timestamp); break;
+            case NMEASentence::GSV: decodeGSV(m_fields, timestamp); break;
+            case NMEASentence::GST: decodeGST(m_fields, timestamp); break;
+            case NMEASentence::VTG: decodeHeading(HeadingSource::VTG, m_fields, timestamp); break;
+            case NMEASentence::HDT: decodeHeading(HeadingSource::HDT, m_fields, timestamp); break;
+            case NMEASentence::ZDA: decodeZDA(m_fields); break;
+            case NMEASentence::PTNL_GGK: decodeGGK(m_fields, timestamp); break;
+            case NMEASentence::PTNL_AVR: decodeAVR(m_fields, timestamp); break;
+            case NMEASentence::UNKNOWN: break;
+        }
+        if (NMEASentence::UNKNOWN != SENTENCE) {
+            m_lastSentence = SENTENCE;
+        }
+        offset += END;
+    }
+    if (0 < discardedBytes) {
+        m_discardedBytes.fetch_add(discardedBytes, std::memory_order_relaxed);
+    }
+    if (0 < truncatedSentences) {
+        m_truncatedSentences.fetch_add(truncatedSentences, std::memory_order_relaxed);
+    }
+    if (0 < invalidChecksums) {
+        m_invalidChecksums.fetch_add(invalidChecksums, std::memory_order_relaxed);
+    }
+    return offset;
+}
+
+size_t NMEADecoder::scanSentence(const uint8_t *sentence, const size_t &size) noexcept {
+    if (0 == m_sentence.scanned) {
+        m_sentence = SentenceState{};
+        m_sentence.scanned = 1;
+        m_fields.begin();
+    }
+
+    auto hexToNibble = [](const uint8_t c) {
+        return static_cast<int32_t>((('0' <= c) && ('9' >= c)) ? (c - '0') :
+                                    ((('A' <= c) && ('F' >= c)) ? (c - 'A' + 10) :
+                                    ((('a' <= c) && ('f' >= c)) ? (c - 'a' + 10) : -1)));
+    };
+
+    const size_t LIMIT{std::min(size, static_cast<size_t>(NMEADecoderConstants::MAX_SENTENCE_LENGTH))};
+    size_t i{m_sentence.scanned};
+    for (; i < LIMIT; i++) {
+        const uint8_t c{sentence[i]};
+        if ('\n' == c) {
+            m_sentence.isComplete = true;
+            break;
+        }
+        if ( ('$' == c) || (0x7E < c) || ((0x20 > c) && ('\r' != c)) ) {
+            break;
+        }
+        if (0 == m_sentence.end) {
+            if (('*' == c) || ('\r' == c)) {
+                m_sentence.end = i;
+                m_sentence.hasChecksum = ('*' == c);
             }
-            {
-                std::string nmeaMessage(reinterpret_cast<char*>(m_buffer+offset), length);
-                auto fields = stringtoolbox::split(nmeaMessage, ',');
-                if (8 < fields.size()) {
-                    double latitude = std::stod(fields[3]) / 100.0;
-                    double longitude = std::stod(fields[5]) / 100.0;
-
-                    latitude = static_cast<int32_t>(latitude) + (latitude - static_cast<int32_t>(latitude)) * 100.0 / 60.0;
-                    longitude = static_cast<int32_t>(longitude) + (longitude - static_cast<int32_t>(longitude)) * 100.0 / 60.0;
-
-                    latitude *= ("S" == fields[4] ? -1.0 : 1.0);
-                    longitude *= ("W" == fields[6] ? -1.0 : 1.0);
-                    if (nullptr != m_delegateLatitudeLongitude) {
-                        m_delegateLatitudeLongitude(latitude, longitude, timestamp);
-                    }
-
-                    const float heading = static_cast<float>(std::stod(fields[8]) / 180.0 * M_PI);
-                    if (nullptr != m_delegateHeading) {
-                        m_delegateHeading(heading, timestamp);
-                    }
-
-                    const float speed = static_cast<float>(std::stod(fields[7]) * 0.514444f);
-                    if (nullptr != m_delegateSpeed) {
-                        m_delegateSpeed(speed, timestamp);
-                    }
+            else {
+                m_sentence.checksum ^= c;
+                if (',' == c) {
+                    m_fields.addSeparator(i);
                 }
             }
-            // Found CRLF; decode message.
-            offset += length;
         }
-        else {
-            // No HEADER bytes found yet; consume one byte.
-            offset++;
+        else if (m_sentence.hasChecksum && (i <= m_sentence.end + 2)) {
+            const int32_t NIBBLE{hexToNibble(c)};
+            m_sentence.hasChecksum = (0 <= NIBBLE);
+            m_sentence.receivedChecksum = static_cast<uint8_t>((m_sentence.receivedChecksum << 4) | (NIBBLE & 0x0F));
         }
     }
-    // We should not get here as we will leave the state machine inside
-    // the while loop at certain point. If we are still getting here,
-    // we simply discard everything and start over.
-    return size;
+
+    if ((i == size) && (i < NMEADecoderConstants::MAX_SENTENCE_LENGTH) && !m_sentence.isComplete) {
+        m_sentence.scanned = i;
+        return 0;
+    }
+    m_sentence.scanned = 0;
+    m_sentence.hasChecksum &= (m_sentence.end + 2 < i);
+    m_fields.end(sentence, (0 == m_sentence.end) ? i : m_sentence.end);
+    // Include the line feed.
+    return (m_sentence.isComplete ? i + 1 : i);
+}
+
+size_t NMEADecoder::findStart(const uint8_t *buffer, const size_t &size) noexcept {
+    // memchr is vectorized; only the range before the next '$' needs to be
+    // searched for the sync characters of binary frames.
+    size_t end{size};
+    for (const uint8_t c : {static_cast<uint8_t>('$'), static_cast<uint8_t>(UBXFrame::SYNC_CHAR_1), static_cast<uint8_t>(RTCM3Frame::PREAMBLE)}) {
+        const void *p{std::memchr(buffer, c, end)};
+        end = (nullptr != p) ? static_cast<size_t>(static_cast<const uint8_t*>(p) - buffer) : end;
+    }
+    return end;
+}
+
+bool NMEADecoder::containsSentence(const uint8_t *buffer, const size_t &size) noexcept {
+    // Smallest sentence: $--XYZ*hh<CR><LF>
+    const uint8_t *end{buffer + size};
+    const uint8_t *c{static_cast<const uint8_t*>(std::memchr(buffer, '$', size))};
+    while ((nullptr != c) && (static_cast<size_t>(end - c) >= NMEADecoderConstants::HEADER_SIZE + 5)) {
+        uint8_t checksum{0};
+        const uint8_t *i{c + 1};
+        for (; (i < end) && ('*' != *i) && ('$' != *i) && (0x20 <= *i) && (0x7E >= *i); i++) {
+            checksum ^= *i;
+        }
+        if ( (i + 5 <= end) && ('*' == i[0]) && ('\r' == i[3]) && ('\n' == i[4]) ) {
+            static const char HEX[] = "0123456789ABCDEF";
+            auto toUpper = [](const uint8_t x) { return static_cast<char>((('a' <= x) && ('f' >= x)) ? x - 'a' + 'A' : x); };
+            if ( (HEX[checksum >> 4] == toUpper(i[1])) && (HEX[checksum & 0x0F] == toUpper(i[2])) ) {
+                return true;
+            }
+        }
+        c = ((i < end) ? static_cast<const uint8_t*>(std::memchr(c + 1, '$', static_cast<size_t>(end - c - 1))) : nullptr);
+    }
+    return false;
 }
 
+NMEADecoder::NMEASentence NMEADecoder::sentence(const NMEAFields &fields) noexcept {
+    // Standard sentences have the header $--XYZ; proprietary Trimble
+    // sentences have the header $PTNL followed by the sentence ID as field.
+    const char *id{nullptr};
+    if ( (6 == fields.length(0)) ) {
+        id = fields.data(0) + 3;
+    }
+    else if ( (5 == fields.length(0)) && (0 == std::strncmp(fields.data(0), "$PTNL", 5)) && (3 == fields.length(1)) ) {
+        id = fields.data(1);
+    }
+    if (nullptr == id) {
+        return NMEASentence::UNKNOWN;
+    }
+
+    const bool IS_PTNL{'P' == fields.data(0)[1]};
+    const uint32_t KEY{(static_cast<uint32_t>(id[0]) << 16) | (static_cast<uint32_t>(id[1]) << 8) | static_cast<uint32_t>(id[2])};
+    constexpr uint32_t GGA{('G' << 16) | ('G' << 8) | 'A'};
+    constexpr uint32_t RMC{('R' << 16) | ('M' << 8) | 'C'};
+    constexpr uint32_t GSA{('G' << 16) | ('S' << 8) | 'A'};
+    constexpr uint32_t GSV{('G' << 16) | ('S' << 8) | 'V'};
+    constexpr uint32_t GST{('G' << 16) | ('S' << 8) | 'T'};
+    constexpr uint32_t VTG{('V' << 16) | ('T' << 8) | 'G'};
+    constexpr uint32_t HDT{('H' << 16) | ('D' << 8) | 'T'};
+    constexpr uint32_t ZDA{('Z' << 16) | ('D' << 8) | 'A'};
+    constexpr uint32_t GGK{('G' << 16) | ('G' << 8) | 'K'};
+    constexpr uint32_t AVR{('A' << 16) | ('V' << 8) | 'R'};
+
+    NMEASentence retVal{NMEASentence::UNKNOWN};
+    switch (KEY) {
+        case GGA: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::GGA); break;
+        case RMC: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::RMC); break;
+        case GSA: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::GSA); break;
+        case GSV: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::GSV); break;
+        case GST: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::GST); break;
+        case VTG: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::VTG); break;
+        case HDT: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::HDT); break;
+        case ZDA: retVal = (IS_PTNL ? NMEASentence::UNKNOWN : NMEASentence::ZDA); break;
+        case GGK: retVal = (IS_PTNL ? NMEASentence::PTNL_GGK : NMEASentence::UNKNOWN); break;
+        case AVR: retVal = (IS_PTNL ? NMEASentence::PTNL_AVR : NMEASentence::UNKNOWN); break;
+        default: break;
+    }
+    return retVal;
+}
+
+bool NMEADecoder::decodeLatitudeLongitude(const NMEAFields &fields, const size_t &index, int64_t &latitude, int64_t &longitude) noexcept {
+    if (!fields.toCoordinate(index, latitude) || !fields.toCoordinate(index + 2, longitude)) {
+        return false;
+    }
+    latitude *= ('S' == fields.toChar(index + 1) ? -1 : 1);
+    longitude *= ('W' == fields.toChar(index + 3) ? -1 : 1);
+    return true;
+}
+
+double NMEADecoder::toDegrees(const int64_t &nanoMinutes) noexcept {
+    // Both operands are exact in double, so the quotient is correctly rounded.
+    return static_cast<double>(nanoMinutes) / 60e9;
+}
+
+void NMEADecoder::decodeGGA(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    if (5 >= fields.size()) {
+        return;
+    }
+    const std::chrono::system_clock::time_point sampleTimePoint{sampleTime(fields.data(1), fields.length(1), nullptr, 0, arrival)};
+    m_lastSampleTime = sampleTimePoint;
+    // Fix quality 0 marks an invalid position; the quality itself is still reported.
+    const bool IS_VALID{'0' != fields.toChar(6)};
+
+    int64_t latitude{0};
+    int64_t longitude{0};
+    if ( IS_VALID && ((nullptr != m_delegateLatitudeLongitude) || (nullptr != m_delegateEpoch)) && decodeLatitudeLongitude(fields, 2, latitude, longitude) ) {
+        if (nullptr != m_delegateLatitudeLongitude) {
+            m_delegateLatitudeLongitude(toDegrees(latitude), toDegrees(longitude), sampleTimePoint);
+        }
+        setEpochPosition(latitude, longitude, sampleTimePoint);
+    }
+
+    float altitude{0.0f};
+    if (IS_VALID && fields.toFloat(9, altitude)) {
+        if (nullptr != m_delegateAltitude) {
+            m_delegateAltitude(altitude, sampleTimePoint);
+        }
+        m_epoch.altitude = altitude;
+        m_epoch.hasAltitude = true;
+        m_epoch.hasGeoidSeparation = fields.toFloat(11, m_epoch.geoidSeparation);
+    }
+
+    NMEAFixQuality quality;
+    if ( (nullptr != m_delegateFixQuality) && fields.toUInt32(6, quality.fixQuality) ) {
+        fields.toUInt32(7, quality.numberOfSatellites);
+        fields.toFloat(8, quality.hdop);
+        fields.toFloat(11, quality.geoidSeparation);
+        m_delegateFixQuality(quality, sampleTimePoint);
+    }
+}
+
+void NMEADecoder::decodeRMC(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    if (8 >= fields.size()) {
+        return;
+    }
+    const std::chrono::system_clock::time_point sampleTimePoint{sampleTime(fields.data(1), fields.length(1), fields.data(9), fields.length(9), arrival)};
+    m_lastSampleTime = sampleTimePoint;
+    // Status 'V' and mode indicator 'N' (NMEA 2.3) mark invalid fixes; only the time is used.
+    if ( ('V' == fields.toChar(2)) || ('N' == fields.toChar(12)) ) {
+        return;
+    }
+
+    int64_t latitude{0};
+    int64_t longitude{0};
+    if ( ((nullptr != m_delegateLatitudeLongitude) || (nullptr != m_delegateEpoch)) && decodeLatitudeLongitude(fields, 3, latitude, longitude) ) {
+        if (nullptr != m_delegateLatitudeLongitude) {
+            m_delegateLatitudeLongitude(toDegrees(latitude), toDegrees(longitude), sampleTimePoint);
+        }
+        setEpochPosition(latitude, longitude, sampleTimePoint);
+    }
+
+    double heading{0.0};
+    if ( (nullptr != m_delegateHeading) && fields.toDouble(8, heading) && isBestHeadingSource(HeadingSource::RMC, arrival) ) {
+        m_delegateHeading(static_cast<float>(heading / 180.0 * M_PI), sampleTimePoint);
+    }
+
+    double speed{0.0};
+    if ( (nullptr != m_delegateSpeed) && fields.toDouble(7, speed) ) {
+        m_delegateSpeed(static_cast<float>(speed * 0.514444f), sampleTimePoint);
+    }
+}
+
+void NMEADecoder::decodeGSA(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    // $--GSA,a,x,prn,prn,prn,prn,prn,prn,prn,prn,prn,prn,prn,prn,p.p,h.h,v.v[,s]
+    if (17 >= fields.size()) {
+        return;
+    }
+    SatelliteTable::Constellation constellation{SatelliteTable::constellation(fields.data(0) + 1)};
+    uint32_t systemID{0};
+    if (fields.toUInt32(18, systemID)) {
+        constellation = SatelliteTable::constellationFromSystemID(systemID);
+    }
+
+    // The first GSA of an epoch discards the satellites used before so that
+    // constellations missing from this epoch do not keep counting.
+    if (NMEASentence::GSA != m_lastSentence) {
+        m_satelliteTable.clearUsed();
+    }
+
+    // Combined sentences without system ID are split by the PRN ranges of
+    // NMEA 2.x; SBAS satellites are reported along with GPS.
+    std::array<uint64_t, SatelliteTable::NUMBER_OF_CONSTELLATIONS> used{};
+    uint32_t constellations{(SatelliteTable::NUMBER_OF_CONSTELLATIONS > constellation) ? (1u << constellation) : 0u};
+    for (size_t i{3}; i < 15; i++) {
+        uint32_t prn{0};
+        SatelliteTable::Constellation c{SatelliteTable::UNKNOWN_CONSTELLATION};
+        uint32_t slot{0};
+        if (fields.toUInt32(i, prn) && SatelliteTable::locate(constellation, prn, c, slot)) {
+            used[c] |= (static_cast<uint64_t>(1) << slot);
+            constellations |= (1u << c);
+        }
+    }
+    for (uint32_t c{0}; c < SatelliteTable::NUMBER_OF_CONSTELLATIONS; c++) {
+        if (0 != (constellations & (1u << c))) {
+            m_satelliteTable.setUsed(static_cast<SatelliteTable::Constellation>(c), used[c]);
+        }
+    }
+
+    if ( (nullptr != m_delegateDilution) || (nullptr != m_delegateEpoch) ) {
+        NMEADilution dilution;
+        fields.toUInt32(2, dilution.fixType);
+        fields.toFloat(15, dilution.pdop);
+        fields.toFloat(16, dilution.hdop);
+        fields.toFloat(17, dilution.vdop);
+        dilution.numberOfSatellitesUsed = m_satelliteTable.numberOfUsed();
+        if (nullptr != m_delegateDilution) {
+            m_delegateDilution(dilution, epochTime(arrival));
+        }
+        // Combined receivers repeat the same DOP in each GSA of the epoch.
+        m_epoch.dilution = dilution;
+        m_epoch.hasDilution = true;
+    }
+}
+
+void NMEADecoder::decodeGSV(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    const SatelliteTable::Constellation constellation{SatelliteTable::constellation(fields.data(0) + 1)};
+    // Up to four satellites per sentence, optionally followed by a signal ID (hex digit).
+    const bool HAS_SIGNAL_ID{(4 < fields.size()) && (1 == (fields.size() - 4) % 4)};
+    const char SIGNAL{HAS_SIGNAL_ID ? fields.toChar(fields.size() - 1) : '0'};
+    const uint32_t SIGNAL_ID{static_cast<uint32_t>((('A' <= SIGNAL) && ('F' >= SIGNAL)) ? SIGNAL - 'A' + 10 : SIGNAL - '0')};
+    uint32_t sentenceNumber{0};
+    uint32_t numberOfSentences{0};
+    if ( (nullptr == m_delegateSatellites) ||
+         (3 >= fields.size()) ||
+         (15 < SIGNAL_ID) ||
+         !fields.toUInt32(1, numberOfSentences) ||
+         !fields.toUInt32(2, sentenceNumber) ||
+         !m_satelliteTable.beginSentence(constellation, SIGNAL_ID, sentenceNumber, numberOfSentences) ) {
+        return;
+    }
+
+    for (size_t i{4}; (i + 3) < fields.size(); i += 4) {
+        uint32_t prn{0};
+        if (fields.toUInt32(i, prn)) {
+            double elevation{0.0};
+            uint32_t azimuth{0};
+            uint32_t snr{SatelliteTable::NO_SNR};
+            fields.toDouble(i + 1, elevation);
+            fields.toUInt32(i + 2, azimuth);
+            fields.toUInt32(i + 3, snr);
+            m_satelliteTable.add(constellation, prn, static_cast<int32_t>(elevation), azimuth, snr);
+        }
+    }
+    // SBAS satellites reported along with GPS complete their own view.
+    const uint32_t COMPLETED{m_satelliteTable.endSentence(constellation)};
+    if (0 != COMPLETED) {
+        const std::chrono::system_clock::time_point sampleTimePoint{epochTime(arrival)};
+        for (uint32_t c{0}; c < SatelliteTable::NUMBER_OF_CONSTELLATIONS; c++) {
+            if (0 != (COMPLETED & (1u << c))) {
+                m_delegateSatellites(m_satelliteTable, static_cast<SatelliteTable::Constellation>(c), sampleTimePoint);
+            }
+        }
+    }
+}
+
+void NMEADecoder::decodeGST(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    NMEAPositionError error;
+    if ( ((nullptr == m_delegatePositionError) && (nullptr == m_delegateEpoch)) ||
+         (8 >= fields.size()) ||
+         !fields.toFloat(6, error.sigmaLatitude) ||
+         !fields.toFloat(7, error.sigmaLongitude) ) {
+        return;
+    }
+    // GST carries the time of the epoch it refers to.
+    const std::chrono::system_clock::time_point sampleTimePoint{sampleTime(fields.data(1), fields.length(1), nullptr, 0, arrival)};
+    fields.toFloat(2, error.rms);
+    fields.toFloat(3, error.semiMajor);
+    fields.toFloat(4, error.semiMinor);
+    fields.toFloat(5, error.orientation);
+    fields.toFloat(8, error.sigmaAltitude);
+    error.orientation = static_cast<float>(error.orientation / 180.0 * M_PI);
+    if (nullptr != m_delegatePositionError) {
+        m_delegatePositionError(error, sampleTimePoint);
+    }
+    // GST follows the position of its epoch.
+    m_epoch.positionError = error;
+    m_epoch.hasPositionError = true;
+}
+
+void NMEADecoder::decodeHeading(const HeadingSource &source, const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    // VTG and HDT carry the true course/heading in field 1; VTG's mode
+    // indicator 'N' (NMEA 2.3) marks an invalid course.
+    double heading{0.0};
+    if ( (nullptr != m_delegateHeading) &&
+         ((HeadingSource::VTG != source) || ('N' != fields.toChar(9))) &&
+         fields.toDouble(1, heading) &&
+         isBestHeadingSource(source, arrival) ) {
+        m_delegateHeading(static_cast<float>(heading / 180.0 * M_PI), epochTime(arrival));
+    }
+}
+
+void NMEADecoder::decodeZDA(const NMEAFields &fields) noexcept {
+    // $--ZDA,hhmmss.ss,dd,mm,yyyy,zz,zz; only the UTC date is of interest.
+    uint32_t day{0};
+    uint32_t month{0};
+    uint32_t year{0};
+    int64_t milliseconds{0};
+    if ( m_useGNSSTime &&
+         GNSSDate::parseTimeOfDay(fields.data(1), fields.length(1), milliseconds) &&
+         fields.toUInt32(2, day) &&
+         fields.toUInt32(3, month) &&
+         fields.toUInt32(4, year) ) {
+        if (m_gnssDate.update(milliseconds)) {
+            m_gnssDate.setDate(year, month, day);
+        }
+    }
+}
+
+void NMEADecoder::decodeGGK(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    // $PTNL,GGK,hhmmss.ss,mmddyy,llll.ll,a,yyyyy.yy,a,q,ss,d.d,EHTh.hh,M
+    if (7 >= fields.size()) {
+        return;
+    }
+    // Reorder the date from mmddyy to ddmmyy.
+    char date[6]{0, 0, 0, 0, 0, 0};
+    size_t dateLength{0};
+    if (6 == fields.length(3)) {
+        const char *mmddyy{fields.data(3)};
+        date[0] = mmddyy[2]; date[1] = mmddyy[3];
+        date[2] = mmddyy[0]; date[3] = mmddyy[1];
+        date[4] = mmddyy[4]; date[5] = mmddyy[5];
+        dateLength = 6;
+    }
+    const std::chrono::system_clock::time_point sampleTimePoint{sampleTime(fields.data(2), fields.length(2), date, dateLength, arrival)};
+    m_lastSampleTime = sampleTimePoint;
+    // Quality 0 marks an invalid position like in GGA; only the time is used.
+    const bool IS_VALID{'0' != fields.toChar(8)};
+
+    int64_t latitude{0};
+    int64_t longitude{0};
+    if ( IS_VALID && ((nullptr != m_delegateLatitudeLongitude) || (nullptr != m_delegateEpoch)) && decodeLatitudeLongitude(fields, 4, latitude, longitude) ) {
+        if (nullptr != m_delegateLatitudeLongitude) {
+            m_delegateLatitudeLongitude(toDegrees(latitude), toDegrees(longitude), sampleTimePoint);
+        }
+        setEpochPosition(latitude, longitude, sampleTimePoint);
+    }
+}
+
+void NMEADecoder::decodeAVR(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept {
+    // $PTNL,AVR,hhmmss.ss,+yyy.yyyy,Yaw,+t.tttt,Tilt,+r.rrrr,Roll,d.ddd,q,p.p,ss
+    NMEAAttitude attitude;
+    if ( (3 >= fields.size()) || !fields.toFloat(3, attitude.yaw) ) {
+        return;
+    }
+    const std::chrono::system_clock::time_point sampleTimePoint{sampleTime(fields.data(2), fields.length(2), nullptr, 0, arrival)};
+    // Quality 0 marks an invalid yaw; the attitude is still reported with its quality.
+    const bool IS_VALID{'0' != fields.toChar(10)};
+
+    // The yaw between the antennas is a true heading like HDT.
+    if ( IS_VALID && (nullptr != m_delegateHeading) && isBestHeadingSource(HeadingSource::HDT, arrival) ) {
+        double heading{attitude.yaw};
+        heading += ((0.0 > heading) ? 360.0 : 0.0);
+        m_delegateHeading(static_cast<float>(heading / 180.0 * M_PI), sampleTimePoint);
+    }
+
+    if (nullptr != m_delegateAttitude) {
+        fields.toFloat(5, attitude.tilt);
+        fields.toFloat(7, attitude.roll);
+        fields.toFloat(9, attitude.range);
+        fields.toUInt32(10, attitude.quality);
+        attitude.yaw = static_cast<float>(attitude.yaw / 180.0 * M_PI);
+        attitude.tilt = static_cast<float>(attitude.tilt / 180.0 * M_PI);
+        attitude.roll = static_cast<float>(attitude.roll / 180.0 * M_PI);
+        m_delegateAttitude(attitude, sampleTimePoint);
+    }
+}
+
+void NMEADecoder::decodeNAVPVT(const uint8_t *payload, const std::chrono::system_clock::time_point &arrival) noexcept {
+    // Fixed offsets into the 92 bytes of UBX-NAV-PVT.
+    const uint8_t VALID{payload[11]};
+    const uint8_t FIX_TYPE{payload[20]};
+    const uint8_t FLAGS{payload[21]};
+    const bool GNSS_FIX_OK{(0x01 == (FLAGS & 0x01)) && (0 < FIX_TYPE) && (5 > FIX_TYPE)};
+
+    std::chrono::system_clock::time_point sampleTimePoint{arrival};
+    const int64_t TIME_OF_DAY{(payload[8] * 3600 + payload[9] * 60 + payload[10]) * 1000LL};
+    if (0x03 == (VALID & 0x03)) {
+        // Epochs at more than 1 Hz differ in the fraction of the second only.
+        beginEpoch(TIME_OF_DAY + (UBXFrame::load<int32_t>(payload + 16) + 500000) / 1000000);
+    }
+    if (m_useGNSSTime && (0x03 == (VALID & 0x03))) {
+        const bool IS_CURRENT{m_gnssDate.update(TIME_OF_DAY)};
+        if ( (IS_CURRENT && m_gnssDate.setDate(UBXFrame::load<uint16_t>(payload + 4), payload[6], payload[7])) ||
+             (!IS_CURRENT && m_gnssDate.hasDate()) ) {
+            sampleTimePoint = m_gnssDate.timePoint(TIME_OF_DAY) +
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(UBXFrame::load<int32_t>(payload + 16)));
+            m_lastSampleTime = sampleTimePoint;
+        }
+    }
+
+    if (nullptr != m_delegateFixQuality) {
+        // Map fix type and carrier solution to GGA's fix quality; NAV-PVT carries no HDOP.
+        const uint8_t CARRIER_SOLUTION{static_cast<uint8_t>(FLAGS >> 6)};
+        NMEAFixQuality quality;
+        quality.fixQuality = (!GNSS_FIX_OK ? 0 : (1 == FIX_TYPE ? 6 : (2 == CARRIER_SOLUTION ? 4 : (1 == CARRIER_SOLUTION ? 5 : (0x02 == (FLAGS & 0x02) ? 2 : 1)))));
+        quality.numberOfSatellites = payload[23];
+        quality.geoidSeparation = static_cast<float>(UBXFrame::load<int32_t>(payload + 32) - UBXFrame::load<int32_t>(payload + 36)) / 1000.0f;
+        m_delegateFixQuality(quality, sampleTimePoint);
+    }
+    if (!GNSS_FIX_OK) {
+        return;
+    }
+
+    // 1e-7 degrees are 6000 nano minutes.
+    const int64_t LONGITUDE{UBXFrame::load<int32_t>(payload + 24) * 6000LL};
+    const int64_t LATITUDE{UBXFrame::load<int32_t>(payload + 28) * 6000LL};
+    if (nullptr != m_delegateLatitudeLongitude) {
+        m_delegateLatitudeLongitude(toDegrees(LATITUDE), toDegrees(LONGITUDE), sampleTimePoint);
+    }
+    setEpochPosition(LATITUDE, LONGITUDE, sampleTimePoint);
+    const float ALTITUDE{static_cast<float>(UBXFrame::load<int32_t>(payload + 36)) / 1000.0f};
+    if (nullptr != m_delegateAltitude) {
+        m_delegateAltitude(ALTITUDE, sampleTimePoint);
+    }
+    m_epoch.altitude = ALTITUDE;
+    m_epoch.hasAltitude = true;
+    m_epoch.geoidSeparation = static_cast<float>(UBXFrame::load<int32_t>(payload + 32) - UBXFrame::load<int32_t>(payload + 36)) / 1000.0f;
+    m_epoch.hasGeoidSeparation = true;
+    if (nullptr != m_delegateSpeed) {
+        m_delegateSpeed(static_cast<float>(UBXFrame::load<int32_t>(payload + 60)) / 1000.0f, sampleTimePoint);
+    }
+    // The heading of motion is a course over ground like VTG and only
+    // meaningful while moving; the heading of the vehicle is only valid with
+    // sensor fusion but also when standing still and ranks above any course
+    // but below a true heading between two antennas.
+    const bool HEAD_VEH_VALID{0x20 == (FLAGS & 0x20)};
+    const bool IS_MOVING{NMEADecoderConstants::MIN_SPEED_FOR_COURSE <= UBXFrame::load<int32_t>(payload + 60)};
+    const HeadingSource SOURCE{HEAD_VEH_VALID ? HeadingSource::VEHICLE : HeadingSource::VTG};
+    if ( (nullptr != m_delegateHeading) && (HEAD_VEH_VALID || IS_MOVING) && isBestHeadingSource(SOURCE, arrival) ) {
+        const int32_t HEADING{UBXFrame::load<int32_t>(payload + (HEAD_VEH_VALID ? 84 : 64))};
+        m_delegateHeading(static_cast<float>(HEADING * 1e-5 / 180.0 * M_PI), sampleTimePoint);
+    }
+    // NAV-PVT only provides horizontal and vertical accuracy estimates.
+    NMEAPositionError error;
+    error.sigmaLatitude = static_cast<float>(UBXFrame::load<uint32_t>(payload + 40)) / 1000.0f;
+    error.sigmaLongitude = error.sigmaLatitude;
+    error.semiMajor = error.sigmaLatitude;
+    error.semiMinor = error.sigmaLatitude;
+    error.sigmaAltitude = static_cast<float>(UBXFrame::load<uint32_t>(payload + 44)) / 1000.0f;
+    if (nullptr != m_delegatePositionError) {
+        m_delegatePositionError(error, sampleTimePoint);
+    }
+    m_epoch.positionError = error;
+    m_epoch.hasPositionError = true;
+}
@@ -18,10 +18,85 @@
 #ifndef NMEA_DECODER
 #define NMEA_DECODER
 
+#include "gnss-date.hpp"
+#include "nmea-fields.hpp"
+#include "satellite-table.hpp"
+
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <string>
 
+/**
+ * Quality information about a fix as reported by GGA.
+ */
+struct NMEAFixQuality {
+    uint32_t fixQuality{0};
+    uint32_t numberOfSatellites{0};
+    float hdop{0.0f};
+    float geoidSeparation{0.0f};
+};
+
+/**
+ * Dilution of precision and satellites used in the solution as reported by
+ * GSA; the number of satellites counts the GSA sentences of the current epoch.
+ */
+struct NMEADilution {
+    uint32_t fixType{0};
+    uint32_t numberOfSatellitesUsed{0};
+    float pdop{0.0f};
+    float hdop{0.0f};
+    float vdop{0.0f};
+};
+
+/**
+ * Pseudorange error statistics as reported by GST; sigmas are in meters and
+ * the orientation of the error ellipse is in radians from true north.
+ */
+struct NMEAPositionError {
+    float rms{0.0f};
+    float semiMajor{0.0f};
+    float semiMinor{0.0f};
+    float orientation{0.0f};
+    float sigmaLatitude{0.0f};
+    float sigmaLongitude{0.0f};
+    float sigmaAltitude{0.0f};
+};
+
+/**
+ * Fix of one epoch combining the sentences that carry the same time of day:
+ * the position from GGA, RMC, PTNL,GGK, or NAV-PVT together with its error
+ * statistics from GST and the dilution of precision from the GSA sentences
+ * following it. The altitude is above mean sea level; adding the geoid
+ * separation gives the height above the ellipsoid.
+ */
+struct NMEAEpoch {
+    double latitude{0.0};
+    double longitude{0.0};
+    float altitude{0.0f};
+    float geoidSeparation{0.0f};
+    NMEAPositionError positionError{};
+    NMEADilution dilution{};
+    bool hasAltitude{false};
+    bool hasGeoidSeparation{false};
+    bool hasPositionError{false};
+    bool hasDilution{false};
+};
+
+/**
+ * Attitude between two antennas as reported by Trimble's PTNL,AVR; angles
+ * are in radians and the range between the antennas is in meters.
+ */
+struct NMEAAttitude {
+    float yaw{0.0f};
+    float tilt{0.0f};
+    float roll{0.0f};
+    float range{0.0f};
+    uint32_t quality{0};
+};
+
 class NMEADecoder {
    private:
     NMEADecoder(const NMEADecoder &) = delete;
@@ -38,17 +113,204 @@ class NMEADecoder {
    public:
     void decode(const std::string &data, std::chrono::system_clock::time_point &&tp) noexcept;
 
+    /**
+     * When enabled, the time points passed to the delegates are derived from
+     * the UTC time reported by the GPS unit instead of the time of arrival;
+     * until a date is known, the time of arrival is used.
+     *
+     * @param enabled True to use the GPS unit's time.
+     */
+    void useGNSSTime(const bool &enabled) noexcept;
+
+    /**
+     * @return Number of bytes that did not belong to any NMEA sentence, UBX
+     *         frame, or RTCM3 frame; may be read from another thread.
+     */
+    uint64_t discardedBytes() const noexcept;
+
+    /**
+     * @return Number of sentences that were interrupted or too long.
+     */
+    uint64_t truncatedSentences() const noexcept;
+
+    /**
+     * @return Number of sentences that were not decoded as their checksum did not match.
+     */
+    uint64_t invalidChecksums() const noexcept;
+
+    /**
+     * @param delegateAltitude Delegate to be called with the altitude above mean sea level from GGA.
+     */
+    void setDelegateAltitude(std::function<void(const float &altitude, const std::chrono::system_clock::time_point &tp)> delegateAltitude) noexcept;
+
+    /**
+     * @param delegateFixQuality Delegate to be called with the fix quality from GGA.
+     */
+    void setDelegateFixQuality(std::function<void(const NMEAFixQuality &quality, const std::chrono::system_clock::time_point &tp)> delegateFixQuality) noexcept;
+
+    /**
+     * @param delegatePositionError Delegate to be called with the error
+     *        statistics from GST; the time point refers to the same epoch as
+     *        the position from GGA.
+     */
+    void setDelegatePositionError(std::function<void(const NMEAPositionError &error, const std::chrono::system_clock::time_point &tp)> delegatePositionError) noexcept;
+
+    /**
+     * @param delegateEpoch Delegate to be called with the combined fix of an
+     *        epoch that had a position once the first sentence of the next
+     *        epoch arrives; the time point is the one of the position.
+     */
+    void setDelegateEpoch(std::function<void(const NMEAEpoch &epoch, const std::chrono::system_clock::time_point &tp)> delegateEpoch) noexcept;
+
+    /**
+     * @param delegateDilution Delegate to be called with the DOP values from GSA.
+     */
+    void setDelegateDilution(std::function<void(const NMEADilution &dilution, const std::chrono::system_clock::time_point &tp)> delegateDilution) noexcept;
+
+    /**
+     * @param delegateAttitude Delegate to be called with the attitude from PTNL,AVR.
+     */
+    void setDelegateAttitude(std::function<void(const NMEAAttitude &attitude, const std::chrono::system_clock::time_point &tp)> delegateAttitude) noexcept;
+
+    /**
+     * @param delegateSatellites Delegate to be called with the satellite table
+     *        when a GSV group for a constellation is complete; with GNSS time,
+     *        the time point is the one of the last sentence carrying a time.
+     */
+    void setDelegateSatellites(std::function<void(const SatelliteTable &table, const SatelliteTable::Constellation &constellation, const std::chrono::system_clock::time_point &tp)> delegateSatellites) noexcept;
+
+    /**
+     * @param delegateRTCM3Frame Delegate to be called with each complete RTCM3 frame with valid CRC found in the stream.
+     */
+    void setDelegateRTCM3Frame(std::function<void(const char *frame, const size_t &length, const std::chrono::system_clock::time_point &tp)> delegateRTCM3Frame) noexcept;
+
+    /**
+     * @param delegateRawSentence Delegate to be called with each complete NMEA
+     *        sentence including its line ending that has a valid checksum.
+     */
+    void setDelegateRawSentence(std::function<void(const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &tp)> delegateRawSentence) noexcept;
+
+   private:
+    // Heading sources in increasing priority; VTG includes NAV-PVT's heading
+    // of motion, VEHICLE is NAV-PVT's heading of the vehicle, and HDT
+    // includes PTNL,AVR.
+    enum HeadingSource {
+        RMC                       = 0,
+        VTG                       = 1,
+        VEHICLE                   = 2,
+        HDT                       = 3,
+        NUMBER_OF_HEADING_SOURCES = 4,
+    };
+
+    enum class NMEASentence {
+        UNKNOWN,
+        GGA,
+        RMC,
+        GSA,
+        GSV,
+        GST,
+        VTG,
+        HDT,
+        ZDA,
+        PTNL_GGK,
+        PTNL_AVR,
+    };
+
+    // Progress on the sentence being received; kept across calls to decode.
+    struct SentenceState {
+        size_t scanned{0};
+        size_t end{0};
+        uint8_t checksum{0};
+        uint8_t receivedChecksum{0};
+        bool hasChecksum{false};
+        bool isComplete{false};
+
+        bool hasValidChecksum() const noexcept {
+            return hasChecksum && (checksum == receivedChecksum);
+        }
+    };
+
    private:
     size_t parseBuffer(const uint8_t *buffer, const size_t size, std::chrono::system_clock::time_point &&tp);
+    /**
+     * @param sentence Sentence starting with '$'; the same sentence is passed
+     *        again with more data after 0 was returned.
+     * @param size Number of bytes available.
+     * @return 0 if incomplete, length including line feed if complete, or
+     *         the number of bytes to skip if interrupted.
+     */
+    size_t scanSentence(const uint8_t *sentence, const size_t &size) noexcept;
+    static size_t findStart(const uint8_t *buffer, const size_t &size) noexcept;
+    /**
+     * @return true if buffer contains a complete NMEA sentence with valid checksum.
+     */
+    static bool containsSentence(const uint8_t *buffer, const size_t &size) noexcept;
+    static NMEASentence sentence(const NMEAFields &fields) noexcept;
+    // Coordinates are kept in 1e-9 minutes and only converted to degrees for the delegates.
+    static bool decodeLatitudeLongitude(const NMEAFields &fields, const size_t &index, int64_t &latitude, int64_t &longitude) noexcept;
+    static double toDegrees(const int64_t &nanoMinutes) noexcept;
+    void decodeGGA(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeRMC(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeGSA(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeGSV(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeGST(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeHeading(const HeadingSource &source, const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeZDA(const NMEAFields &fields) noexcept;
+    void decodeGGK(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeAVR(const NMEAFields &fields, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void decodeNAVPVT(const uint8_t *payload, const std::chrono::system_clock::time_point &arrival) noexcept;
+    std::chrono::system_clock::time_point epochTime(const std::chrono::system_clock::time_point &arrival) const noexcept;
+    bool isBestHeadingSource(const HeadingSource &source, const std::chrono::system_clock::time_point &arrival) noexcept;
+    std::chrono::system_clock::time_point sampleTime(const char *timeOfDay, const size_t &timeOfDayLength, const char *date, const size_t &dateLength, const std::chrono::system_clock::time_point &arrival) noexcept;
+    void beginEpoch(const int64_t &timeOfDay) noexcept;
+    void setEpochPosition(const int64_t &latitude, const int64_t &longitude, const std::chrono::system_clock::time_point &tp) noexcept;
 
    private:
     uint8_t *m_buffer{nullptr};
     size_t m_size{0};
 
+   private:
+    std::atomic<uint64_t> m_discardedBytes{0};
+    std::atomic<uint64_t> m_truncatedSentences{0};
+    std::atomic<uint64_t> m_invalidChecksums{0};
+
+   private:
+    SentenceState m_sentence{};
+    NMEAFields m_fields{};
+
+   private:
+    bool m_useGNSSTime{false};
+    // Current UTC day from RMC, ZDA, PTNL,GGK, or NAV-PVT.
+    GNSSDate m_gnssDate{};
+    // Sentences without time (e.g., GSV) refer to the last epoch.
+    std::chrono::system_clock::time_point m_lastSampleTime{};
+
+   private:
+    // Epoch being combined; identified by its time of day.
+    NMEAEpoch m_epoch{};
+    int64_t m_epochTimeOfDay{-1};
+    bool m_epochHasPosition{false};
+    std::chrono::system_clock::time_point m_epochTime{};
+
+   private:
+    SatelliteTable m_satelliteTable{};
+    // Consecutive GSA sentences report the satellites used in one epoch.
+    NMEASentence m_lastSentence{NMEASentence::UNKNOWN};
+    std::array<std::chrono::system_clock::time_point, NUMBER_OF_HEADING_SOURCES> m_lastHeading{};
+
    private:
     std::function<void(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp)> m_delegateLatitudeLongitude{};
     std::function<void(const float &heading, const std::chrono::system_clock::time_point &tp)> m_delegateHeading{};
     std::function<void(const float &speed, const std::chrono::system_clock::time_point &tp)> m_delegateSpeed{};
+    std::function<void(const float &altitude, const std::chrono::system_clock::time_point &tp)> m_delegateAltitude{};
+    std::function<void(const NMEAFixQuality &quality, const std::chrono::system_clock::time_point &tp)> m_delegateFixQuality{};
+    std::function<void(const NMEAPositionError &error, const std::chrono::system_clock::time_point &tp)> m_delegatePositionError{};
+    std::function<void(const NMEAEpoch &epoch, const std::chrono::system_clock::time_point &tp)> m_delegateEpoch{};
+    std::function<void(const NMEADilution &dilution, const std::chrono::system_clock::time_point &tp)> m_delegateDilution{};
+    std::function<void(const NMEAAttitude &attitude, const std::chrono::system_clock::time_point &tp)> m_delegateAttitude{};
+    std::function<void(const SatelliteTable &table, const SatelliteTable::Constellation &constellation, const std::chrono::system_clock::time_point &tp)> m_delegateSatellites{};
+    std::function<void(const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &tp)> m_delegateRawSentence{};
+    std::function<void(const char *frame, const size_t &length, const std::chrono::system_clock::time_point &tp)> m_delegateRTCM3Frame{};
 };
 
 #endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NMEA_FIELDS
+#define NMEA_FIELDS
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * NMEAFields records the begin of each comma-separated field of one NMEA
+ * sentence in a single pass without copying the sentence, either at once
+ * or incrementally while the sentence is received. Field 0 is the
+ * header (e.g., $GPGGA); tokenizing ends at '*', CR, or LF. The fields are
+ * only valid as long as the tokenized sentence is.
+ */
+class NMEAFields {
+   public:
+    enum NMEAFieldsConstants {
+        MAX_FIELDS = 40,
+    };
+
+   public:
+    NMEAFields() = default;
+
+   public:
+    /**
+     * @param sentence Sentence to tokenize.
+     * @param length Length of the sentence.
+     * @return Number of fields found.
+     */
+    size_t tokenize(const uint8_t *sentence, const size_t &length) noexcept {
+        begin();
+        size_t i{0};
+        for (; i < length; i++) {
+            const uint8_t c{sentence[i]};
+            if (('*' == c) || ('\r' == c) || ('\n' == c)) {
+                break;
+            }
+            if (',' == c) {
+                addSeparator(i);
+            }
+        }
+        end(sentence, i);
+        return m_size;
+    }
+
+    /**
+     * Starts tokenizing a sentence incrementally as its bytes arrive.
+     */
+    void begin() noexcept {
+        m_sentence = nullptr;
+        m_size = 0;
+        m_begin[m_size++] = 0;
+    }
+
+    /**
+     * @param index Position of a ',' within the sentence.
+     */
+    void addSeparator(const size_t &index) noexcept {
+        if (m_size < MAX_FIELDS) {
+            m_begin[m_size++] = static_cast<uint16_t>(index + 1);
+        }
+    }
+
+    /**
+     * @param sentence Begin of the complete sentence.
+     * @param end Position of the first '*', CR, or LF.
+     */
+    void end(const uint8_t *sentence, const size_t &end) noexcept {
+        m_sentence = reinterpret_cast<const char*>(sentence);
+        // Sentinel to compute the length of the last field.
+        m_begin[m_size] = static_cast<uint16_t>(end + 1);
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    const char *data(const size_t &index) const noexcept {
+        return m_sentence + m_begin[index];
+    }
+
+    size_t length(const size_t &index) const noexcept {
+        return (index < m_size) ? static_cast<size_t>(m_begin[index + 1] - m_begin[index] - 1) : 0;
+    }
+
+    bool isEmpty(const size_t &index) const noexcept {
+        return (0 == length(index));
+    }
+
+    /**
+     * @return First character of the given field or '\0' if empty.
+     */
+    char toChar(const size_t &index) const noexcept {
+        return isEmpty(index) ? '\0' : *data(index);
+    }
+
+    /**
+     * @param index Field to parse as [-]ddd[.ddd].
+     * @param value Parsed value.
+     * @return true if the field is a non-empty decimal number.
+     */
+    bool toDouble(const size_t &index, double &value) const noexcept {
+        const size_t LENGTH{length(index)};
+        if (0 == LENGTH) {
+            return false;
+        }
+        const char *c{data(index)};
+        const char *end{c + LENGTH};
+        const bool IS_NEGATIVE{'-' == *c};
+        c += ((IS_NEGATIVE || ('+' == *c)) ? 1 : 0);
+
+        // Accumulate all digits into one integer and scale once at the end.
+        const char *dot{static_cast<const char*>(std::memchr(c, '.', static_cast<size_t>(end - c)))};
+        const size_t INTEGER_DIGITS{static_cast<size_t>(((nullptr != dot) ? dot : end) - c)};
+        const size_t DECIMALS{(nullptr != dot) ? static_cast<size_t>(end - dot - 1) : 0};
+        if ((0 == INTEGER_DIGITS + DECIMALS) || (19 < INTEGER_DIGITS + DECIMALS) || (22 < DECIMALS)) {
+            return false;
+        }
+        uint64_t mantissa{0};
+        if (!parseDigits(c, INTEGER_DIGITS, mantissa) || !parseDigits(end - DECIMALS, DECIMALS, mantissa)) {
+            return false;
+        }
+        // Powers of ten up to 1e22 are exact in double.
+        static constexpr double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        value = static_cast<double>(mantissa) / POW10[DECIMALS];
+        value = (IS_NEGATIVE ? -value : value);
+        return true;
+    }
+
+    /**
+     * @param index Field to parse as float.
+     * @param value Parsed value.
+     * @return true if the field is a non-empty decimal number.
+     */
+    bool toFloat(const size_t &index, float &value) const noexcept {
+        double tmp{0.0};
+        const bool retVal{toDouble(index, tmp)};
+        value = (retVal ? static_cast<float>(tmp) : value);
+        return retVal;
+    }
+
+    /**
+     * @param index Field to parse as angle in [d]ddmm[.mmmmmmmmm] format.
+     * @param nanoMinutes Parsed angle in 1e-9 minutes; further decimals are truncated.
+     * @return true if the field is a non-empty angle.
+     */
+    bool toCoordinate(const size_t &index, int64_t &nanoMinutes) const noexcept {
+        const size_t LENGTH{length(index)};
+        const char *c{data(index)};
+        const char *end{c + LENGTH};
+
+        // Whole degrees and minutes, e.g., 12202 for 122 degrees and 2 minutes.
+        const char *dot{static_cast<const char*>(std::memchr(c, '.', LENGTH))};
+        const size_t INTEGER_DIGITS{static_cast<size_t>(((nullptr != dot) ? dot : end) - c)};
+        uint64_t degreesMinutes{0};
+        if ((3 > INTEGER_DIGITS) || (5 < INTEGER_DIGITS) || !parseDigits(c, INTEGER_DIGITS, degreesMinutes)) {
+            return false;
+        }
+
+        // Fraction of minutes padded to nine decimals.
+        static constexpr uint64_t POW10[] = {1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+        const size_t DECIMALS{(nullptr != dot) ? static_cast<size_t>(end - dot - 1) : 0};
+        const size_t USED_DECIMALS{(9 < DECIMALS) ? 9 : DECIMALS};
+        uint64_t fraction{0};
+        uint64_t truncated{0};
+        if ( !parseDigits(end - DECIMALS, USED_DECIMALS, fraction) ||
+             !parseDigits(end - DECIMALS + USED_DECIMALS, DECIMALS - USED_DECIMALS, truncated) ) {
+            return false;
+        }
+        nanoMinutes = static_cast<int64_t>(((degreesMinutes / 100) * 60 + (degreesMinutes % 100)) * 1000000000ULL + fraction * POW10[USED_DECIMALS]);
+        return true;
+    }
+
+    /**
+     * @param index Field to parse as unsigned integer.
+     * @param value Parsed value.
+     * @return true if the field is a non-empty integer number.
+     */
+    bool toUInt32(const size_t &index, uint32_t &value) const noexcept {
+        const size_t LENGTH{length(index)};
+        uint64_t tmp{0};
+        if ((0 == LENGTH) || (9 < LENGTH) || !parseDigits(data(index), LENGTH, tmp)) {
+            return false;
+        }
+        value = static_cast<uint32_t>(tmp);
+        return true;
+    }
+
+    /**
+     * Appends a run of decimal digits to value. Eight digits at a time are
+     * validated and combined within one 64-bit register (SWAR) by three
+     * multiply-adds; the remaining digits are added one by one.
+     *
+     * @param c First digit.
+     * @param length Number of digits.
+     * @param value Value to append the digits to.
+     * @return false if any character is not a digit; value is unchanged then.
+     */
+    static bool parseDigits(const char *c, const size_t &length, uint64_t &value) noexcept {
+        uint64_t tmp{value};
+        size_t i{0};
+        for (; (i + 8) <= length; i += 8) {
+            uint64_t chunk{0};
+            std::memcpy(&chunk, c + i, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            chunk = __builtin_bswap64(chunk);
+#endif
+            // All bytes must be in 0x30-0x39: high nibble 3, and adding 6 must not carry.
+            if ( (0x3030303030303030ULL != (chunk & 0xF0F0F0F0F0F0F0F0ULL)) ||
+                 (0x3030303030303030ULL != ((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL)) ) {
+                return false;
+            }
+            // The first digit is in the lowest byte; combine pairs, quads, and octets.
+            chunk -= 0x3030303030303030ULL;
+            chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+            chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+            chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFULL;
+            tmp = tmp * 100000000ULL + chunk;
+        }
+        for (; i < length; i++) {
+            const uint32_t d{static_cast<uint32_t>(c[i] - '0')};
+            if (9 < d) {
+                return false;
+            }
+            tmp = tmp * 10 + d;
+        }
+        value = tmp;
+        return true;
+    }
+
+   private:
+    const char *m_sentence{nullptr};
+    std::array<uint16_t, MAX_FIELDS + 1> m_begin{};
+    size_t m_size{0};
+};
+
+#endif
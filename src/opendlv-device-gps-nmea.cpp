@@ -17,12 +17,29 @@
 
 #include "cluon-complete.hpp"
 #include "opendlv-standard-message-set.hpp"
+#include "opendlv-device-gps-nmea-message-set.hpp"
 
+#include "gnss-filter.hpp"
+#include "heading-estimator.hpp"
+#include "local-tangent-plane.hpp"
+#include "motion-gate.hpp"
 #include "nmea-decoder.hpp"
+#include "output-throttle.hpp"
+#include "position-predictor.hpp"
+#include "rec-writer.hpp"
+#include "stationary-detector.hpp"
+#include "unix-datagram-fanout.hpp"
+#include "utm-projection.hpp"
 
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -32,74 +49,521 @@ int32_t main(int32_t argc, char **argv) {
     auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
     if ( (0 == commandlineArguments.count("nmea_ip")) || (0 == commandlineArguments.count("nmea_port")) || (0 == commandlineArguments.count("cid")) ) {
         std::cerr << argv[0] << " decodes latitude/longitude/heading from a Trimble GPS/INSS unit in NMEA format and publishes it to a running OpenDaVINCI session using the OpenDLV Standard Message Set." << std::endl;
-        std::cerr << "Usage:   " << argv[0] << " --nmea_ip=<IPv4-address> --nmea_port=<port> --cid=<OpenDaVINCI session> [--id=<Identifier in case of multiple OxTS units>] [--udp] [--verbose]" << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --nmea_ip=<IPv4-address> --nmea_port=<port> --cid=<OpenDaVINCI session> [--id=<Identifier in case of multiple OxTS units>] [--udp] [--rate.position=<Hz>] [--rate.heading=<Hz>] [--rate.speed=<Hz>] [--rate.altitude=<Hz>] [--rate.mode=latest|average] [--rec=<file>] [--gnss_time] [--nmea_fanout=<path>] [--rtcm_fanout=<path>] [--enu] [--enu.origin=<lat>,<lon>,<alt>] [--utm] [--utm.zone=<1-60><N|S>] [--predict=<Hz>] [--predict.id=<senderStamp>] [--filter] [--gate] [--gate.margin=<m>] [--derive_heading] [--derive_heading.speed=<m/s>] [--stationary] [--stationary.rate=<Hz>] [--quality] [--fix] [--uncertainty] [--satellites] [--dop] [--attitude] [--verbose]" << std::endl;
         std::cerr << "         --nmea_ip:      IP address of the NMEA providing server to connect to" << std::endl;
         std::cerr << "         --nmea_port:    port of the NMEA providing server to connect to" << std::endl;
         std::cerr << "         --udp:          the given IP-address/port is specifying a local UDP receiver to let a UDP-based provider connect to us" << std::endl;
+        std::cerr << "         --rate.position: maximum rate to publish GeodeticWgs84Reading (default: every decoded sample)" << std::endl;
+        std::cerr << "         --rate.heading:  maximum rate to publish GeodeticHeadingReading (default: every decoded sample)" << std::endl;
+        std::cerr << "         --rate.speed:    maximum rate to publish GroundSpeedReading (default: every decoded sample)" << std::endl;
+        std::cerr << "         --rate.altitude: maximum rate to publish AltitudeReading (default: every decoded sample)" << std::endl;
+        std::cerr << "         --rate.mode:     publish the latest sample (default) or the average over the window when rate limits are used" << std::endl;
+        std::cerr << "         --rec:          record the published Envelopes to the given .rec file" << std::endl;
+        std::cerr << "         --gnss_time:    use the UTC time from the NMEA messages as sampleTimeStamp; the time of arrival is kept as received timestamp" << std::endl;
+        std::cerr << "         --nmea_fanout:  pass on NMEA sentences with valid checksum to local readers attached to this UNIX datagram socket ('@' prefix for abstract namespace)" << std::endl;
+        std::cerr << "         --rtcm_fanout:  pass on RTCM3 frames with valid CRC found in the stream in the same way as --nmea_fanout" << std::endl;
+        std::cerr << "         --enu:          publish positions in meters east, north, and up of an origin" << std::endl;
+        std::cerr << "         --enu.origin:   origin for --enu in degrees and meters above the ellipsoid (default: first position with altitude)" << std::endl;
+        std::cerr << "         --utm:          publish positions as UTM easting and northing" << std::endl;
+        std::cerr << "         --utm.zone:     UTM zone and hemisphere for --utm, e.g., 32N (default: zone of the first position)" << std::endl;
+        std::cerr << "         --predict:      publish GeodeticWgs84Reading extrapolated with ground speed and course at the given rate in between received positions" << std::endl;
+        std::cerr << "         --predict.id:   senderStamp of the extrapolated positions (default: id + 1000)" << std::endl;
+        std::cerr << "         --filter:       publish position, speed, heading, and yaw rate smoothed by a Kalman filter using the sigmas from GST" << std::endl;
+        std::cerr << "         --gate:         drop positions that could not be reached from the last one given the ground speed and publish them as RejectedPosition" << std::endl;
+        std::cerr << "         --gate.margin:  distance in meters always accepted by --gate (default: 10)" << std::endl;
+        std::cerr << "         --derive_heading: publish the heading fitted to the last positions while the unit does not report the course over ground" << std::endl;
+        std::cerr << "         --derive_heading.speed: speed in m/s from which on --derive_heading estimates the heading (default: 1)" << std::endl;
+        std::cerr << "         --stationary:   publish position, heading, speed, and altitude only at a keep-alive rate while the vehicle stands still" << std::endl;
+        std::cerr << "         --stationary.rate: keep-alive rate for --stationary (default: 0.2)" << std::endl;
+        std::cerr << "         --quality:      publish fix quality, number of satellites, and HDOP from GGA" << std::endl;
+        std::cerr << "         --fix:          publish position, altitude, the uncertainty from GST, and DOP from GSA combined per epoch" << std::endl;
+        std::cerr << "         --uncertainty:  publish the position uncertainty from GST stamped with the epoch of the position" << std::endl;
+        std::cerr << "         --satellites:   publish azimuth, elevation, SNR, and use in the solution per satellite in view from GSV and GSA" << std::endl;
+        std::cerr << "         --dop:          publish PDOP, HDOP, VDOP, and the number of satellites used in the solution from GSA" << std::endl;
+        std::cerr << "         --attitude:     publish yaw, tilt, and roll between two antennas from PTNL,AVR" << std::endl;
         std::cerr << "Example: " << argv[0] << " --nmea_ip=10.42.42.112 --nmea_port=9999 --cid=111" << std::endl;
         retCode = 1;
     } else {
         const uint32_t ID{(commandlineArguments["id"].size() != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["id"])) : 0};
         const bool VERBOSE{commandlineArguments.count("verbose") != 0};
         const bool IS_UDP{commandlineArguments.count("udp") != 0};
+        const bool USE_GNSS_TIME{commandlineArguments.count("gnss_time") != 0};
+        const bool PUBLISH_QUALITY{commandlineArguments.count("quality") != 0};
+        const bool PUBLISH_FIX{commandlineArguments.count("fix") != 0};
+        const bool PUBLISH_UNCERTAINTY{commandlineArguments.count("uncertainty") != 0};
+        const bool PUBLISH_SATELLITES{commandlineArguments.count("satellites") != 0};
+        const bool PUBLISH_DOP{commandlineArguments.count("dop") != 0};
+        const bool PUBLISH_ATTITUDE{commandlineArguments.count("attitude") != 0};
+        const bool PUBLISH_ENU{(commandlineArguments.count("enu") != 0) || (commandlineArguments.count("enu.origin") != 0)};
+
+        // Local tangent plane around a given origin or the first position.
+        LocalTangentPlane localTangentPlane;
+        if (0 != commandlineArguments["enu.origin"].size()) {
+            std::stringstream origin{commandlineArguments["enu.origin"]};
+            double latitude{0.0};
+            double longitude{0.0};
+            double altitude{0.0};
+            char separator1{0};
+            char separator2{0};
+            if ( !(origin >> latitude >> separator1 >> longitude >> separator2 >> altitude) || (',' != separator1) || (',' != separator2) ) {
+                std::cerr << "[" << argv[0] << "] Invalid origin '" << commandlineArguments["enu.origin"] << "'; expected <lat>,<lon>,<alt>." << std::endl;
+                return 1;
+            }
+            localTangentPlane.setOrigin(latitude, longitude, altitude);
+        }
+        // One UTM zone for the whole run to avoid jumps at zone borders.
+        const bool PUBLISH_UTM{(commandlineArguments.count("utm") != 0) || (commandlineArguments.count("utm.zone") != 0)};
+        std::unique_ptr<UTMProjection> utmProjection;
+        if (0 != commandlineArguments["utm.zone"].size()) {
+            const std::string ZONE{commandlineArguments["utm.zone"]};
+            const char HEMISPHERE{static_cast<char>(std::toupper(ZONE.back()))};
+            const uint32_t NUMBER{static_cast<uint32_t>(std::strtoul(ZONE.c_str(), nullptr, 10))};
+            if ( (1 > NUMBER) || (60 < NUMBER) || (('N' != HEMISPHERE) && ('S' != HEMISPHERE)) ) {
+                std::cerr << "[" << argv[0] << "] Invalid UTM zone '" << ZONE << "'; expected, e.g., 32N." << std::endl;
+                return 1;
+            }
+            utmProjection.reset(new UTMProjection(NUMBER, 'N' == HEMISPHERE));
+        }
+
+        // The altitude arrives after the position of the same epoch, so local
+        // positions are completed with the epoch once all its sentences are in.
+        std::array<double, 2> pendingLocalPosition{};
+        std::chrono::system_clock::time_point pendingLocalPositionTime{};
+        bool hasPendingLocalPosition{false};
+
+        // Per message type rate limits to reduce the load on the network.
+        auto getRate = [&commandlineArguments](const std::string &name) {
+            return (commandlineArguments[name].size() != 0) ? std::stof(commandlineArguments[name]) : 0.0f;
+        };
+        const OutputThrottleMode RATE_MODE{("average" == commandlineArguments["rate.mode"]) ? OutputThrottleMode::AVERAGE : OutputThrottleMode::LATEST};
+        const bool IS_AVERAGING{OutputThrottleMode::AVERAGE == RATE_MODE};
+        // Longitude and heading are averaged on the unit circle to handle the wrap-around.
+        OutputThrottle<3> positionThrottle{getRate("rate.position"), RATE_MODE};
+        OutputThrottle<2> headingThrottle{getRate("rate.heading"), RATE_MODE};
+        OutputThrottle<1> speedThrottle{getRate("rate.speed"), RATE_MODE};
+        OutputThrottle<1> altitudeThrottle{getRate("rate.altitude"), RATE_MODE};
+
+        // Keep-alive rate while the vehicle stands still; full rate as soon as it moves.
+        const bool IS_DETECTING_STATIONARY{(commandlineArguments.count("stationary") != 0) || (commandlineArguments.count("stationary.rate") != 0)};
+        const float KEEP_ALIVE_RATE{(commandlineArguments["stationary.rate"].size() != 0) ? getRate("stationary.rate") : 0.2f};
+        StationaryDetector stationaryDetector;
+        OutputThrottle<3> positionKeepAlive{KEEP_ALIVE_RATE, OutputThrottleMode::LATEST};
+        OutputThrottle<2> headingKeepAlive{KEEP_ALIVE_RATE, OutputThrottleMode::LATEST};
+        OutputThrottle<1> speedKeepAlive{KEEP_ALIVE_RATE, OutputThrottleMode::LATEST};
+        OutputThrottle<1> altitudeKeepAlive{KEEP_ALIVE_RATE, OutputThrottleMode::LATEST};
+
+        // Constant velocity prediction in between received positions.
+        const float PREDICT_RATE{getRate("predict")};
+        const uint32_t PREDICT_ID{(commandlineArguments["predict.id"].size() != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["predict.id"])) : ID + 1000};
+        PositionPredictor positionPredictor;
+
+        // Kalman filter fed with the received samples before rate limiting.
+        const bool PUBLISH_FILTERED{commandlineArguments.count("filter") != 0};
+        GNSSFilter gnssFilter;
+
+        // Reject jumps before any other stage sees the position.
+        const bool IS_GATING{(commandlineArguments.count("gate") != 0) || (commandlineArguments.count("gate.margin") != 0)};
+        MotionGate motionGate{(commandlineArguments["gate.margin"].size() != 0) ? std::stod(commandlineArguments["gate.margin"]) : 10.0};
+
+        // Heading from positions for units configured without RMC or VTG.
+        const bool IS_DERIVING_HEADING{(commandlineArguments.count("derive_heading") != 0) || (commandlineArguments.count("derive_heading.speed") != 0)};
+        HeadingEstimator headingEstimator{(commandlineArguments["derive_heading.speed"].size() != 0) ? std::stod(commandlineArguments["derive_heading.speed"]) : 1.0};
+        std::chrono::system_clock::time_point lastReportedHeading{};
 
         // Interface to a running OpenDaVINCI session (ignoring any incoming Envelopes).
         cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"])),
             [](auto){}
         };
 
+        // Record the published Envelopes directly instead of via a separate recorder.
+        std::unique_ptr<RecWriter> recWriter;
+        if (0 != commandlineArguments["rec"].size()) {
+            recWriter.reset(new RecWriter(commandlineArguments["rec"]));
+            if (!recWriter->isOpen()) {
+                std::cerr << "[" << argv[0] << "] Could not open '" << commandlineArguments["rec"] << "' for recording." << std::endl;
+                return 1;
+            }
+        }
+
+        // Time of arrival of the data that is currently decoded.
+        std::chrono::system_clock::time_point received;
+
+        auto publishAt = [&od4Session = od4, &recWriter, VERBOSE](auto &message, const std::chrono::system_clock::time_point &tp, const uint32_t &senderStamp, const std::chrono::system_clock::time_point &arrival) {
+            cluon::ToProtoVisitor protoEncoder;
+            message.accept(protoEncoder);
+
+            cluon::data::Envelope envelope;
+            envelope.dataType(static_cast<int32_t>(message.ID()))
+                .serializedData(protoEncoder.encodedData())
+                .sent(cluon::time::now())
+                .received(cluon::time::convert(arrival))
+                .sampleTimeStamp(cluon::time::convert(tp))
+                .senderStamp(senderStamp);
+            if (nullptr != recWriter) {
+                recWriter->write(cluon::data::Envelope(envelope));
+            }
+            od4Session.send(std::move(envelope));
+
+            // Print values on console.
+            if (VERBOSE) {
+                std::stringstream buffer;
+                message.accept([](uint32_t, const std::string &, const std::string &) {},
+                               [&buffer](uint32_t, std::string &&, std::string &&n, auto v) { buffer << n << " = " << std::setprecision(9) << v << '\n'; },
+                               []() {});
+                std::cout << buffer.str() << std::endl;
+            }
+        };
+        auto publish = [&publishAt, &received](auto &message, const std::chrono::system_clock::time_point &tp, const uint32_t &senderStamp) {
+            publishAt(message, tp, senderStamp, received);
+        };
+
+        auto onHeading = [&publish, &throttle = headingThrottle, IS_DETECTING_STATIONARY, &stationaryDetector, &keepAlive = headingKeepAlive, IS_AVERAGING, PREDICT_RATE, &positionPredictor, PUBLISH_FILTERED, &gnssFilter, senderStamp = ID](const float &heading, const std::chrono::system_clock::time_point &tp) {
+            if (0.0f < PREDICT_RATE) {
+                positionPredictor.setHeading(heading);
+            }
+            if (PUBLISH_FILTERED) {
+                gnssFilter.setHeading(heading, tp);
+            }
+
+            std::array<double, 2> values{{heading, 0.0}};
+            if (IS_AVERAGING) {
+                values[0] = std::cos(heading);
+                values[1] = std::sin(heading);
+            }
+            if (!throttle.update(values, tp)) {
+                return;
+            }
+            if (IS_DETECTING_STATIONARY && stationaryDetector.isStationary() && !keepAlive.update(values, tp)) {
+                return;
+            }
+
+            float northHeading{heading};
+            if (IS_AVERAGING) {
+                const double MEAN{std::atan2(values[1], values[0])};
+                northHeading = static_cast<float>((0.0 > MEAN) ? MEAN + 2.0 * M_PI : MEAN);
+            }
+            opendlv::proxy::GeodeticHeadingReading m;
+            m.northHeading(northHeading);
+            publish(m, tp, senderStamp);
+        };
+
         NMEADecoder nmeaDecoder{
-            [&od4Session = od4, senderStamp = ID, VERBOSE](const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) {
+            [&publish, &throttle = positionThrottle, IS_DETECTING_STATIONARY, &stationaryDetector, &keepAlive = positionKeepAlive, IS_AVERAGING, PUBLISH_ENU, &pendingLocalPosition, &pendingLocalPositionTime, &hasPendingLocalPosition, PUBLISH_UTM, &utmProjection, PREDICT_RATE, &positionPredictor, &received, PUBLISH_FILTERED, &gnssFilter, IS_GATING, &motionGate, IS_DERIVING_HEADING, &headingEstimator, &lastReportedHeading, &onHeading, senderStamp = ID](const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) {
+                if (IS_GATING && !motionGate.accept(latitude, longitude, tp)) {
+                    opendlv::device::gps::nmea::RejectedPosition m;
+                    m.latitude(latitude)
+                     .longitude(longitude)
+                     .rejectedPositions(static_cast<uint32_t>(motionGate.rejectedPositions()))
+                     .acceptedPositions(static_cast<uint32_t>(motionGate.acceptedPositions()));
+                    publish(m, tp, senderStamp);
+                    return;
+                }
+                if (IS_DETECTING_STATIONARY) {
+                    stationaryDetector.setPosition(latitude, longitude, tp);
+                }
+                // Prefer the course over ground whenever the unit reports it.
+                float derivedHeading{0.0f};
+                if (IS_DERIVING_HEADING && headingEstimator.update(latitude, longitude, tp, derivedHeading) && (std::chrono::seconds(2) < tp - lastReportedHeading)) {
+                    onHeading(derivedHeading, tp);
+                }
+                if (0.0f < PREDICT_RATE) {
+                    positionPredictor.setPosition(latitude, longitude, tp, received);
+                }
+                if (PUBLISH_FILTERED) {
+                    gnssFilter.setPosition(latitude, longitude, tp);
+                }
+
+                constexpr double DEG2RAD{M_PI / 180.0};
+                std::array<double, 3> values{{latitude, longitude, 0.0}};
+                if (IS_AVERAGING) {
+                    values[1] = std::cos(longitude * DEG2RAD);
+                    values[2] = std::sin(longitude * DEG2RAD);
+                }
+                if (!throttle.update(values, tp)) {
+                    return;
+                }
+                if (IS_DETECTING_STATIONARY && stationaryDetector.isStationary() && !keepAlive.update(values, tp)) {
+                    return;
+                }
+
+                // The filter sees every position but is published like them.
+                if (PUBLISH_FILTERED) {
+                    const GNSSFilterState STATE{gnssFilter.state()};
+                    opendlv::device::gps::nmea::FilteredState f;
+                    f.latitude(STATE.latitude)
+                     .longitude(STATE.longitude)
+                     .groundSpeed(STATE.groundSpeed)
+                     .northHeading(STATE.northHeading)
+                     .yawRate(STATE.yawRate)
+                     .sigmaPosition(STATE.sigmaPosition);
+                    publish(f, tp, senderStamp);
+                }
+
                 opendlv::proxy::GeodeticWgs84Reading m;
-                m.latitude(latitude).longitude(longitude);
-                od4Session.send(m, cluon::time::convert(tp), senderStamp);
+                m.latitude(values[0]).longitude(IS_AVERAGING ? std::atan2(values[2], values[1]) / DEG2RAD : values[1]);
+                publish(m, tp, senderStamp);
 
-                // Print values on console.
-                if (VERBOSE) {
-                    std::stringstream buffer;
-                    m.accept([](uint32_t, const std::string &, const std::string &) {},
-                             [&buffer](uint32_t, std::string &&, std::string &&n, auto v) { buffer << n << " = " << std::setprecision(9) << v << '\n'; },
-                             []() {});
-                    std::cout << buffer.str() << std::endl;
+                if (PUBLISH_ENU) {
+                    pendingLocalPosition = std::array<double, 2>{{m.latitude(), m.longitude()}};
+                    pendingLocalPositionTime = tp;
+                    hasPendingLocalPosition = true;
                 }
-            },
-            [&od4Session = od4, senderStamp = ID, VERBOSE](const float &heading, const std::chrono::system_clock::time_point &tp) {
-                opendlv::proxy::GeodeticHeadingReading m;
-                m.northHeading(heading);
-                od4Session.send(m, cluon::time::convert(tp), senderStamp);
-
-                // Print values on console.
-                if (VERBOSE) {
-                    std::stringstream buffer;
-                    m.accept([](uint32_t, const std::string &, const std::string &) {},
-                             [&buffer](uint32_t, std::string &&, std::string &&n, auto v) { buffer << n << " = " << std::setprecision(9) << v << '\n'; },
-                             []() {});
-                    std::cout << buffer.str() << std::endl;
+
+                if (PUBLISH_UTM) {
+                    if (nullptr == utmProjection) {
+                        utmProjection.reset(new UTMProjection(UTMProjection::zone(m.latitude(), m.longitude()), 0.0 <= m.latitude()));
+                    }
+                    double easting{0.0};
+                    double northing{0.0};
+                    utmProjection->toUTM(m.latitude(), m.longitude(), easting, northing);
+                    opendlv::device::gps::nmea::UTMPosition p;
+                    p.easting(easting)
+                     .northing(northing)
+                     .zone(utmProjection->zone())
+                     .isNorth(utmProjection->isNorth());
+                    publish(p, tp, senderStamp);
                 }
             },
-            [&od4Session = od4, senderStamp = ID, VERBOSE](const float &speed, const std::chrono::system_clock::time_point &tp) {
+            [&onHeading, &lastReportedHeading](const float &heading, const std::chrono::system_clock::time_point &tp) {
+                lastReportedHeading = tp;
+                onHeading(heading, tp);
+            },
+            [&publish, &throttle = speedThrottle, IS_DETECTING_STATIONARY, &stationaryDetector, &keepAlive = speedKeepAlive, PREDICT_RATE, &positionPredictor, PUBLISH_FILTERED, &gnssFilter, IS_GATING, &motionGate, senderStamp = ID](const float &speed, const std::chrono::system_clock::time_point &tp) {
+                if (IS_GATING) {
+                    motionGate.setSpeed(speed);
+                }
+                if (IS_DETECTING_STATIONARY) {
+                    stationaryDetector.setSpeed(speed, tp);
+                }
+                if (0.0f < PREDICT_RATE) {
+                    positionPredictor.setSpeed(speed);
+                }
+                if (PUBLISH_FILTERED) {
+                    gnssFilter.setSpeed(speed, tp);
+                }
+
+                std::array<double, 1> values{{speed}};
+                if (!throttle.update(values, tp)) {
+                    return;
+                }
+                if (IS_DETECTING_STATIONARY && stationaryDetector.isStationary() && !keepAlive.update(values, tp)) {
+                    return;
+                }
+
                 opendlv::proxy::GroundSpeedReading m;
-                m.groundSpeed(speed);
-                od4Session.send(m, cluon::time::convert(tp), senderStamp);
+                m.groundSpeed(static_cast<float>(values[0]));
+                publish(m, tp, senderStamp);
+            }
+        };
+
+        nmeaDecoder.useGNSSTime(USE_GNSS_TIME);
+        nmeaDecoder.setDelegateAltitude([&publish, &throttle = altitudeThrottle, IS_DETECTING_STATIONARY, &stationaryDetector, &keepAlive = altitudeKeepAlive, senderStamp = ID](const float &altitude, const std::chrono::system_clock::time_point &tp) {
+            std::array<double, 1> values{{altitude}};
+            if (!throttle.update(values, tp)) {
+                return;
+            }
+            if (IS_DETECTING_STATIONARY && stationaryDetector.isStationary() && !keepAlive.update(values, tp)) {
+                return;
+            }
+
+            opendlv::proxy::AltitudeReading m;
+            m.altitude(static_cast<float>(values[0]));
+            publish(m, tp, senderStamp);
+        });
+        if (PUBLISH_QUALITY) {
+            nmeaDecoder.setDelegateFixQuality([&publish, senderStamp = ID](const NMEAFixQuality &quality, const std::chrono::system_clock::time_point &tp) {
+                opendlv::device::gps::nmea::FixQuality m;
+                m.fixQuality(quality.fixQuality)
+                 .numberOfSatellites(quality.numberOfSatellites)
+                 .hdop(quality.hdop)
+                 .geoidSeparation(quality.geoidSeparation);
+                publish(m, tp, senderStamp);
+            });
+        }
+        if (PUBLISH_FIX || PUBLISH_ENU) {
+            nmeaDecoder.setDelegateEpoch([&publish, PUBLISH_FIX, PUBLISH_ENU, &localTangentPlane, &pendingLocalPosition, &pendingLocalPositionTime, &hasPendingLocalPosition, senderStamp = ID](const NMEAEpoch &epoch, const std::chrono::system_clock::time_point &tp) {
+                // Only positions that passed the gate and the throttles are published locally.
+                if (PUBLISH_ENU && hasPendingLocalPosition && (pendingLocalPositionTime == tp) && (epoch.hasAltitude || localTangentPlane.hasOrigin())) {
+                    // Height above the ellipsoid; epochs without altitude (e.g., RMC only) are taken at the height of the origin.
+                    const double HEIGHT{epoch.hasAltitude ? static_cast<double>(epoch.altitude) + static_cast<double>(epoch.geoidSeparation) : localTangentPlane.origin()[2]};
+                    if (!localTangentPlane.hasOrigin()) {
+                        localTangentPlane.setOrigin(pendingLocalPosition[0], pendingLocalPosition[1], HEIGHT);
+                    }
+                    const std::array<double, 3> ENU{localTangentPlane.toENU(pendingLocalPosition[0], pendingLocalPosition[1], HEIGHT)};
+                    const std::array<double, 3> &ORIGIN{localTangentPlane.origin()};
+                    opendlv::device::gps::nmea::LocalPosition p;
+                    p.east(ENU[0])
+                     .north(ENU[1])
+                     .up(static_cast<float>(ENU[2]))
+                     .originLatitude(ORIGIN[0])
+                     .originLongitude(ORIGIN[1])
+                     .originAltitude(static_cast<float>(ORIGIN[2]));
+                    publish(p, tp, senderStamp);
+                }
+                hasPendingLocalPosition = false;
+                if (!PUBLISH_FIX) {
+                    return;
+                }
 
-                // Print values on console.
-                if (VERBOSE) {
-                    std::stringstream buffer;
-                    m.accept([](uint32_t, const std::string &, const std::string &) {},
-                             [&buffer](uint32_t, std::string &&, std::string &&n, auto v) { buffer << n << " = " << std::setprecision(9) << v << '\n'; },
-                             []() {});
-                    std::cout << buffer.str() << std::endl;
+                opendlv::device::gps::nmea::Fix m;
+                m.latitude(epoch.latitude)
+                 .longitude(epoch.longitude)
+                 .altitude(epoch.altitude)
+                 .sigmaLatitude(epoch.hasPositionError ? epoch.positionError.sigmaLatitude : -1.0f)
+                 .sigmaLongitude(epoch.hasPositionError ? epoch.positionError.sigmaLongitude : -1.0f)
+                 .sigmaAltitude(epoch.hasPositionError ? epoch.positionError.sigmaAltitude : -1.0f)
+                 .numberOfSatellitesUsed(epoch.dilution.numberOfSatellitesUsed)
+                 .pdop(epoch.hasDilution ? epoch.dilution.pdop : -1.0f)
+                 .hdop(epoch.hasDilution ? epoch.dilution.hdop : -1.0f)
+                 .vdop(epoch.hasDilution ? epoch.dilution.vdop : -1.0f);
+                publish(m, tp, senderStamp);
+            });
+        }
+        if (PUBLISH_UNCERTAINTY || PUBLISH_FILTERED) {
+            nmeaDecoder.setDelegatePositionError([&publish, PUBLISH_UNCERTAINTY, PUBLISH_FILTERED, &gnssFilter, senderStamp = ID](const NMEAPositionError &error, const std::chrono::system_clock::time_point &tp) {
+                if (PUBLISH_FILTERED) {
+                    gnssFilter.setPositionError(error.sigmaLatitude, error.sigmaLongitude);
+                }
+                if (!PUBLISH_UNCERTAINTY) {
+                    return;
                 }
+
+                opendlv::device::gps::nmea::PositionUncertainty m;
+                m.sigmaLatitude(error.sigmaLatitude)
+                 .sigmaLongitude(error.sigmaLongitude)
+                 .sigmaAltitude(error.sigmaAltitude)
+                 .semiMajor(error.semiMajor)
+                 .semiMinor(error.semiMinor)
+                 .orientation(error.orientation)
+                 .rms(error.rms);
+                publish(m, tp, senderStamp);
+            });
+        }
+        if (PUBLISH_DOP) {
+            nmeaDecoder.setDelegateDilution([&publish, senderStamp = ID](const NMEADilution &dilution, const std::chrono::system_clock::time_point &tp) {
+                opendlv::device::gps::nmea::DilutionOfPrecision m;
+                m.fixType(dilution.fixType)
+                 .numberOfSatellitesUsed(dilution.numberOfSatellitesUsed)
+                 .pdop(dilution.pdop)
+                 .hdop(dilution.hdop)
+                 .vdop(dilution.vdop);
+                publish(m, tp, senderStamp);
+            });
+        }
+        if (PUBLISH_ATTITUDE) {
+            nmeaDecoder.setDelegateAttitude([&publish, senderStamp = ID](const NMEAAttitude &attitude, const std::chrono::system_clock::time_point &tp) {
+                opendlv::device::gps::nmea::Attitude m;
+                m.yaw(attitude.yaw)
+                 .tilt(attitude.tilt)
+                 .roll(attitude.roll)
+                 .range(attitude.range)
+                 .quality(attitude.quality);
+                publish(m, tp, senderStamp);
+            });
+        }
+        if (PUBLISH_SATELLITES) {
+            nmeaDecoder.setDelegateSatellites([&publish, senderStamp = ID](const SatelliteTable &table, const SatelliteTable::Constellation &constellation, const std::chrono::system_clock::time_point &tp) {
+                constexpr float DEG2RAD{static_cast<float>(M_PI / 180.0)};
+                const uint64_t USED{table.usedInView(constellation)};
+                for (uint64_t inView{table.inView(constellation)}; 0 != inView; inView &= (inView - 1)) {
+                    const uint32_t slot{static_cast<uint32_t>(__builtin_ctzll(inView))};
+                    const uint32_t snr{table.snr(constellation, slot)};
+                    opendlv::device::gps::nmea::SatelliteInView m;
+                    m.constellation(static_cast<uint32_t>(constellation))
+                     .prn(table.prn(constellation, slot))
+                     .elevation(static_cast<float>(table.elevation(constellation, slot)) * DEG2RAD)
+                     .azimuth(static_cast<float>(table.azimuth(constellation, slot)) * DEG2RAD)
+                     .snr((SatelliteTable::NO_SNR == snr) ? -1.0f : static_cast<float>(snr))
+                     .used(0 != (USED & (static_cast<uint64_t>(1) << slot)));
+                    publish(m, tp, senderStamp);
+                }
+            });
+        }
+
+        // Local fan-out of the raw NMEA sentences.
+        std::unique_ptr<UNIXDatagramFanOut> nmeaFanOut;
+        if (0 != commandlineArguments["nmea_fanout"].size()) {
+            nmeaFanOut.reset(new UNIXDatagramFanOut(commandlineArguments["nmea_fanout"]));
+            if (!nmeaFanOut->isRunning()) {
+                std::cerr << "[" << argv[0] << "] Could not bind '" << commandlineArguments["nmea_fanout"] << "' for passing on NMEA sentences." << std::endl;
+                return 1;
+            }
+            nmeaDecoder.setDelegateRawSentence([&fanOut = *nmeaFanOut](const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &) {
+                fanOut.send(sentence, length);
+            });
+        }
+
+        // Local fan-out of RTCM3 corrections multiplexed into the stream.
+        std::unique_ptr<UNIXDatagramFanOut> rtcmFanOut;
+        if (0 != commandlineArguments["rtcm_fanout"].size()) {
+            rtcmFanOut.reset(new UNIXDatagramFanOut(commandlineArguments["rtcm_fanout"]));
+            if (!rtcmFanOut->isRunning()) {
+                std::cerr << "[" << argv[0] << "] Could not bind '" << commandlineArguments["rtcm_fanout"] << "' for passing on RTCM3 frames." << std::endl;
+                return 1;
+            }
+            nmeaDecoder.setDelegateRTCM3Frame([&fanOut = *rtcmFanOut](const char *frame, const size_t &length, const std::chrono::system_clock::time_point &) {
+                fanOut.send(frame, length);
+            });
+        }
+
+        // Report noise on the link instead of skipping it silently.
+        uint64_t lastDiscardedBytes{0};
+        uint64_t lastDroppedEnvelopes{0};
+        uint64_t lastRejectedPositions{0};
+        auto reportDiscardedBytes = [&argv, &nmeaDecoder, &recWriter, &motionGate, &lastDiscardedBytes, &lastDroppedEnvelopes, &lastRejectedPositions]() {
+            const uint64_t DISCARDED_BYTES{nmeaDecoder.discardedBytes()};
+            if (DISCARDED_BYTES != lastDiscardedBytes) {
+                std::cerr << "[" << argv[0] << "] Discarded " << (DISCARDED_BYTES - lastDiscardedBytes) << " bytes not belonging to any valid NMEA sentence, UBX frame, or RTCM3 frame (" << nmeaDecoder.truncatedSentences() << " truncated sentences and " << nmeaDecoder.invalidChecksums() << " sentences with invalid checksum in total)." << std::endl;
+                lastDiscardedBytes = DISCARDED_BYTES;
+            }
+            const uint64_t DROPPED_ENVELOPES{(nullptr != recWriter) ? recWriter->droppedEnvelopes() : 0};
+            if (DROPPED_ENVELOPES != lastDroppedEnvelopes) {
+                std::cerr << "[" << argv[0] << "] Dropped " << (DROPPED_ENVELOPES - lastDroppedEnvelopes) << " Envelopes as writing the .rec file could not keep up." << std::endl;
+                lastDroppedEnvelopes = DROPPED_ENVELOPES;
+            }
+            const uint64_t REJECTED_POSITIONS{motionGate.rejectedPositions()};
+            if (REJECTED_POSITIONS != lastRejectedPositions) {
+                std::cerr << "[" << argv[0] << "] Rejected " << (REJECTED_POSITIONS - lastRejectedPositions) << " positions inconsistent with the ground speed (" << motionGate.acceptedPositions() << " accepted in total)." << std::endl;
+                lastRejectedPositions = REJECTED_POSITIONS;
             }
         };
 
+        // Publish predicted positions from a timer thread as the decoding is data driven.
+        std::atomic<bool> isPredicting{0.0f < PREDICT_RATE};
+        std::thread predictionThread;
+        if (isPredicting) {
+            predictionThread = std::thread([&publishAt, &positionPredictor, &isPredicting, IS_DETECTING_STATIONARY, &stationaryDetector, PREDICT_RATE, PREDICT_ID]() {
+                const std::chrono::steady_clock::duration PERIOD{std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(PREDICT_RATE)))};
+                std::chrono::steady_clock::time_point next{std::chrono::steady_clock::now()};
+                while (isPredicting.load()) {
+                    next += PERIOD;
+                    std::this_thread::sleep_until(next);
+                    // A parked vehicle needs no positions in between; the
+                    // received ones are already at the keep-alive rate.
+                    if (IS_DETECTING_STATIONARY && stationaryDetector.isStationary()) {
+                        continue;
+                    }
+                    const std::chrono::system_clock::time_point NOW{std::chrono::system_clock::now()};
+                    double latitude{0.0};
+                    double longitude{0.0};
+                    std::chrono::system_clock::time_point tp;
+                    if (positionPredictor.predict(NOW, latitude, longitude, tp)) {
+                        opendlv::proxy::GeodeticWgs84Reading m;
+                        m.latitude(latitude).longitude(longitude);
+                        publishAt(m, tp, PREDICT_ID, NOW);
+                    }
+                }
+            });
+        }
+
         // Interface to a Trimble unit providing data in NMEA format.
         const std::string NMEA_ADDRESS(commandlineArguments["nmea_ip"]);
         const uint16_t NMEA_PORT(std::stoi(commandlineArguments["nmea_port"]));
 
         if (IS_UDP) {
             cluon::UDPReceiver fromDevice{NMEA_ADDRESS, NMEA_PORT,
-                [&decoder = nmeaDecoder](std::string &&d, std::string &&/*from*/, std::chrono::system_clock::time_point &&tp) noexcept {
+                [&decoder = nmeaDecoder, &received](std::string &&d, std::string &&/*from*/, std::chrono::system_clock::time_point &&tp) noexcept {
+                    received = tp;
                     decoder.decode(d, std::move(tp));
                 }
             };
@@ -108,11 +572,13 @@ int32_t main(int32_t argc, char **argv) {
             using namespace std::literals::chrono_literals;
             while (od4.isRunning()) {
                 std::this_thread::sleep_for(1s);
+                reportDiscardedBytes();
             }
         }
         else {
             cluon::TCPConnection fromDevice{NMEA_ADDRESS, NMEA_PORT,
-                [&decoder = nmeaDecoder](std::string &&d, std::chrono::system_clock::time_point &&tp) noexcept {
+                [&decoder = nmeaDecoder, &received](std::string &&d, std::chrono::system_clock::time_point &&tp) noexcept {
+                    received = tp;
                     decoder.decode(d, std::move(tp));
                 },
                 [&argv](){ std::cerr << "[" << argv[0] << "] Connection lost." << std::endl; exit(1); }
@@ -122,8 +588,14 @@ int32_t main(int32_t argc, char **argv) {
             using namespace std::literals::chrono_literals;
             while (od4.isRunning()) {
                 std::this_thread::sleep_for(1s);
+                reportDiscardedBytes();
             }
         }
+
+        isPredicting.store(false);
+        if (predictionThread.joinable()) {
+            predictionThread.join();
+        }
     }
     return retCode;
 }
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OUTPUT_THROTTLE
+#define OUTPUT_THROTTLE
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+enum class OutputThrottleMode { LATEST, AVERAGE };
+
+/**
+ * OutputThrottle limits the publishing rate of one message type to a given
+ * frequency by comparing sample time points only. In LATEST mode, the most
+ * recent sample at each due time point is let through; in AVERAGE mode, the
+ * samples of the passed window are averaged and the mean is let through.
+ * A rate less than or equal to zero disables throttling.
+ */
+template <std::size_t N>
+class OutputThrottle {
+   private:
+    OutputThrottle(const OutputThrottle &) = delete;
+    OutputThrottle(OutputThrottle &&)      = delete;
+    OutputThrottle &operator=(const OutputThrottle &) = delete;
+    OutputThrottle &operator=(OutputThrottle &&) = delete;
+
+   public:
+    OutputThrottle(const float &rate, const OutputThrottleMode &mode) noexcept
+        : m_enabled(0.0f < rate)
+        , m_mode(mode) {
+        if (m_enabled) {
+            m_period = std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(rate)));
+        }
+        m_sum.fill(0.0);
+    }
+
+   public:
+    /**
+     * @param values Sample to be considered; replaced by the window mean in AVERAGE mode.
+     * @param tp Time point of the sample.
+     * @return true if the sample shall be published.
+     */
+    bool update(std::array<double, N> &values, const std::chrono::system_clock::time_point &tp) noexcept {
+        if (!m_enabled) {
+            return true;
+        }
+
+        if (OutputThrottleMode::AVERAGE == m_mode) {
+            for (std::size_t i{0}; i < N; i++) {
+                m_sum[i] += values[i];
+            }
+            m_count++;
+        }
+
+        // Time going backwards (e.g., replay restarted) resets the schedule.
+        const bool isDue{(!m_hasPublished) || (tp < m_lastPublished) || (tp >= m_next)};
+        if (!isDue) {
+            return false;
+        }
+
+        if (OutputThrottleMode::AVERAGE == m_mode) {
+            for (std::size_t i{0}; i < N; i++) {
+                values[i] = m_sum[i] / static_cast<double>(m_count);
+            }
+            m_sum.fill(0.0);
+            m_count = 0;
+        }
+
+        // Stay on the schedule grid to keep the average rate in the presence
+        // of jitter, but restart it after gaps longer than one period.
+        m_next = ((!m_hasPublished) || (tp < m_lastPublished) || (tp >= m_next + m_period)) ? tp + m_period : m_next + m_period;
+        m_lastPublished = tp;
+        m_hasPublished = true;
+        return true;
+    }
+
+   private:
+    const bool m_enabled;
+    const OutputThrottleMode m_mode;
+    std::chrono::system_clock::duration m_period{0};
+    std::chrono::system_clock::time_point m_next{};
+    std::chrono::system_clock::time_point m_lastPublished{};
+    bool m_hasPublished{false};
+    std::array<double, N> m_sum{};
+    std::size_t m_count{0};
+};
+
+#endif
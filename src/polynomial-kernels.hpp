@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POLYNOMIAL_KERNELS
+#define POLYNOMIAL_KERNELS
+
+#include <cmath>
+
+/**
+ * Branch-free polynomial replacements for the library functions in the
+ * batch conversions; unlike the library calls, they let the compiler
+ * vectorize the conversion loops.
+ */
+namespace PolynomialKernels {
+    /**
+     * Sine and cosine of x in [-pi, pi] from Taylor polynomials of x / 2 in
+     * [-pi / 2, pi / 2] and the double angle identities; the truncation
+     * errors are below 1e-12.
+     */
+    inline void sinCos(const double &x, double &s, double &c) noexcept {
+        const double H{0.5 * x};
+        const double H2{H * H};
+        const double SIN_H{H * (1.0 + H2 * (-1.0 / 6.0 + H2 * (1.0 / 120.0 + H2 * (-1.0 / 5040.0 + H2 * (1.0 / 362880.0 + H2 * (-1.0 / 39916800.0 + H2 * (1.0 / 6227020800.0 + H2 * (-1.0 / 1307674368000.0 + H2 * (1.0 / 355687428096000.0)))))))))};
+        const double COS_H{1.0 + H2 * (-0.5 + H2 * (1.0 / 24.0 + H2 * (-1.0 / 720.0 + H2 * (1.0 / 40320.0 + H2 * (-1.0 / 3628800.0 + H2 * (1.0 / 479001600.0 + H2 * (-1.0 / 87178291200.0 + H2 * (1.0 / 20922789888000.0))))))))};
+        s = 2.0 * SIN_H * COS_H;
+        c = COS_H * COS_H - SIN_H * SIN_H;
+    }
+
+    /**
+     * @return x - 2 * pi * k wrapped into [-pi, pi]; adding and subtracting
+     *         1.5 * 2^52 rounds to the nearest integer without a library call.
+     */
+    inline double wrapAngle(const double &x) noexcept {
+        constexpr double ROUND{6755399441055744.0};
+        const double K{(x * (0.5 / M_PI) + ROUND) - ROUND};
+        return x - 2.0 * M_PI * K;
+    }
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "position-predictor.hpp"
+#include "wgs84.hpp"
+
+#include <cmath>
+
+PositionPredictor::PositionPredictor(const std::chrono::system_clock::duration &maxHorizon) noexcept
+    : m_maxHorizon(maxHorizon) {
+}
+
+void PositionPredictor::setPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &sampleTime, const std::chrono::system_clock::time_point &arrival) noexcept {
+    const std::array<double, 2> METERS_PER_DEGREE{WGS84::metersPerDegree(latitude)};
+
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_latitude = latitude;
+    m_longitude = longitude;
+    m_sampleTime = sampleTime;
+    m_arrival = arrival;
+    m_hasPosition = true;
+    m_metersPerDegreeLatitude = METERS_PER_DEGREE[0];
+    m_metersPerDegreeLongitude = METERS_PER_DEGREE[1];
+    updateRates();
+}
+
+void PositionPredictor::setSpeed(const float &speed) noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_speed = static_cast<double>(speed);
+    updateRates();
+}
+
+void PositionPredictor::setHeading(const float &heading) noexcept {
+    const double SIN_HEADING{std::sin(static_cast<double>(heading))};
+    const double COS_HEADING{std::cos(static_cast<double>(heading))};
+
+    std::lock_guard<std::mutex> lck(m_mutex);
+    m_sinHeading = SIN_HEADING;
+    m_cosHeading = COS_HEADING;
+    updateRates();
+}
+
+void PositionPredictor::updateRates() noexcept {
+    // Close to the poles, longitude is not extrapolated.
+    constexpr double MIN_METERS_PER_DEGREE{1.0};
+    m_latitudeRate = (MIN_METERS_PER_DEGREE < m_metersPerDegreeLatitude) ? m_speed * m_cosHeading / m_metersPerDegreeLatitude : 0.0;
+    m_longitudeRate = (MIN_METERS_PER_DEGREE < m_metersPerDegreeLongitude) ? m_speed * m_sinHeading / m_metersPerDegreeLongitude : 0.0;
+}
+
+bool PositionPredictor::predict(const std::chrono::system_clock::time_point &now, double &latitude, double &longitude, std::chrono::system_clock::time_point &sampleTime) const noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    const std::chrono::system_clock::duration AGE{now - m_arrival};
+    if (!m_hasPosition || (std::chrono::system_clock::duration::zero() > AGE) || (m_maxHorizon < AGE)) {
+        return false;
+    }
+    const double DT{std::chrono::duration<double>(AGE).count()};
+    latitude = m_latitude + m_latitudeRate * DT;
+    longitude = m_longitude + m_longitudeRate * DT;
+    if (180.0 < longitude) {
+        longitude -= 360.0;
+    }
+    else if (-180.0 > longitude) {
+        longitude += 360.0;
+    }
+    sampleTime = m_sampleTime + AGE;
+    return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POSITION_PREDICTOR
+#define POSITION_PREDICTOR
+
+#include <chrono>
+#include <mutex>
+
+/**
+ * PositionPredictor extrapolates the last position with constant velocity
+ * from ground speed and course. Each real position, speed, or course
+ * corrects the prediction; the velocity is then converted into degrees per
+ * second once, so that predicting is two multiply-adds. The time since the
+ * last position is measured against its time of arrival, which keeps the
+ * prediction consistent when the position is stamped with GNSS time.
+ * Corrections and predictions may come from different threads.
+ */
+class PositionPredictor {
+   private:
+    PositionPredictor(const PositionPredictor &) = delete;
+    PositionPredictor(PositionPredictor &&)      = delete;
+    PositionPredictor &operator=(const PositionPredictor &) = delete;
+    PositionPredictor &operator=(PositionPredictor &&) = delete;
+
+   public:
+    /**
+     * @param maxHorizon Time after the last position beyond which no longer
+     *        is predicted, e.g., when the receiver stopped sending.
+     */
+    explicit PositionPredictor(const std::chrono::system_clock::duration &maxHorizon = std::chrono::seconds(1)) noexcept;
+
+   public:
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param sampleTime Time point the position refers to.
+     * @param arrival Time of arrival of the position.
+     */
+    void setPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &sampleTime, const std::chrono::system_clock::time_point &arrival) noexcept;
+
+    /**
+     * @param speed Ground speed in m/s.
+     */
+    void setSpeed(const float &speed) noexcept;
+
+    /**
+     * @param heading Course over ground in radians from true north.
+     */
+    void setHeading(const float &heading) noexcept;
+
+    /**
+     * @param now Current time on the clock of the times of arrival.
+     * @param latitude Predicted latitude in degrees.
+     * @param longitude Predicted longitude in degrees.
+     * @param sampleTime Time point the prediction refers to.
+     * @return true if a position within the horizon is known.
+     */
+    bool predict(const std::chrono::system_clock::time_point &now, double &latitude, double &longitude, std::chrono::system_clock::time_point &sampleTime) const noexcept;
+
+   private:
+    void updateRates() noexcept;
+
+   private:
+    const std::chrono::system_clock::duration m_maxHorizon;
+    mutable std::mutex m_mutex{};
+    bool m_hasPosition{false};
+    double m_latitude{0.0};
+    double m_longitude{0.0};
+    std::chrono::system_clock::time_point m_sampleTime{};
+    std::chrono::system_clock::time_point m_arrival{};
+
+    // Meters per degree at the last position.
+    double m_metersPerDegreeLatitude{0.0};
+    double m_metersPerDegreeLongitude{0.0};
+    double m_speed{0.0};
+    double m_sinHeading{0.0};
+    double m_cosHeading{1.0};
+
+    // Velocity in degrees per second.
+    double m_latitudeRate{0.0};
+    double m_longitudeRate{0.0};
+};
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rec-writer.hpp"
+
+#include <chrono>
+#include <utility>
+
+RecWriter::RecWriter(const std::string &filename, const size_t batchSize, const size_t maxQueueSize) noexcept
+    : m_maxQueueSize((0 < maxQueueSize) ? maxQueueSize : 1)
+    , m_batchSize((0 < batchSize) ? ((batchSize < m_maxQueueSize) ? batchSize : m_maxQueueSize) : 1)
+    , m_recFile(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc) {
+    m_queue.reserve(m_maxQueueSize);
+    if (m_recFile.good()) {
+        m_running.store(true);
+        m_writerThread = std::thread(&RecWriter::run, this);
+    }
+}
+
+RecWriter::~RecWriter() {
+    {
+        std::lock_guard<std::mutex> lck(m_queueMutex);
+        m_running.store(false);
+    }
+    m_queueCondition.notify_all();
+    if (m_writerThread.joinable()) {
+        m_writerThread.join();
+    }
+    m_recFile.flush();
+    m_recFile.close();
+}
+
+bool RecWriter::isOpen() const noexcept {
+    return m_running.load();
+}
+
+void RecWriter::write(cluon::data::Envelope &&envelope) noexcept {
+    if (!m_running.load()) {
+        return;
+    }
+    bool batchComplete{false};
+    {
+        std::lock_guard<std::mutex> lck(m_queueMutex);
+        if (m_queue.size() >= m_maxQueueSize) {
+            m_droppedEnvelopes.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_queue.emplace_back(std::move(envelope));
+        batchComplete = (m_queue.size() >= m_batchSize);
+    }
+    if (batchComplete) {
+        m_queueCondition.notify_one();
+    }
+}
+
+uint64_t RecWriter::droppedEnvelopes() const noexcept {
+    return m_droppedEnvelopes.load(std::memory_order_relaxed);
+}
+
+void RecWriter::run() noexcept {
+    using namespace std::literals::chrono_literals;
+
+    // Swapping the queues keeps their capacities and hence avoids
+    // re-allocations on the publishing path.
+    std::vector<cluon::data::Envelope> envelopes;
+    envelopes.reserve(m_maxQueueSize);
+    bool running{true};
+    while (running) {
+        {
+            std::unique_lock<std::mutex> lck(m_queueMutex);
+            // Write at least once per second to not lose too much data on crashes.
+            m_queueCondition.wait_for(lck, 1s, [this](){ return (!m_running.load()) || (m_queue.size() >= m_batchSize); });
+            running = m_running.load();
+            std::swap(envelopes, m_queue);
+        }
+        flush(envelopes);
+    }
+}
+
+void RecWriter::flush(std::vector<cluon::data::Envelope> &envelopes) noexcept {
+    if (envelopes.empty()) {
+        return;
+    }
+    m_block.clear();
+    for (auto &e : envelopes) {
+        m_block.append(cluon::serializeEnvelope(std::move(e)));
+    }
+    envelopes.clear();
+
+    m_recFile.write(m_block.data(), static_cast<std::streamsize>(m_block.size()));
+    m_recFile.flush();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REC_WRITER
+#define REC_WRITER
+
+#include "cluon-complete.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * RecWriter records Envelopes to a .rec file. The publishing thread only
+ * enqueues the Envelopes; serializing and writing them in large sequential
+ * blocks happens on a background thread. The queue is bounded; when the
+ * disk cannot keep up, further Envelopes are dropped and counted.
+ */
+class RecWriter {
+   private:
+    RecWriter(const RecWriter &) = delete;
+    RecWriter(RecWriter &&)      = delete;
+    RecWriter &operator=(const RecWriter &) = delete;
+    RecWriter &operator=(RecWriter &&) = delete;
+
+   public:
+    /**
+     * @param filename .rec file to be created.
+     * @param batchSize Number of Envelopes after which the background thread is woken up.
+     * @param maxQueueSize Number of queued Envelopes after which further ones are dropped.
+     */
+    RecWriter(const std::string &filename, const size_t batchSize = 256, const size_t maxQueueSize = 4096) noexcept;
+    ~RecWriter();
+
+   public:
+    bool isOpen() const noexcept;
+    void write(cluon::data::Envelope &&envelope) noexcept;
+
+    /**
+     * @return Number of Envelopes dropped because the queue was full.
+     */
+    uint64_t droppedEnvelopes() const noexcept;
+
+   private:
+    void run() noexcept;
+    void flush(std::vector<cluon::data::Envelope> &envelopes) noexcept;
+
+   private:
+    const size_t m_maxQueueSize;
+    const size_t m_batchSize;
+    std::ofstream m_recFile;
+
+    std::mutex m_queueMutex{};
+    std::condition_variable m_queueCondition{};
+    std::vector<cluon::data::Envelope> m_queue{};
+    std::string m_block{};
+
+    std::atomic<uint64_t> m_droppedEnvelopes{0};
+    std::atomic<bool> m_running{false};
+    std::thread m_writerThread{};
+};
+
+#endif
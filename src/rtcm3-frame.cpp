@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rtcm3-frame.hpp"
+
+#include <array>
+
+bool RTCM3Frame::isValid(const uint8_t *buffer, const size_t &length) noexcept {
+    const size_t END{length - CRC_SIZE};
+    const uint32_t CRC{(static_cast<uint32_t>(buffer[END]) << 16) | (static_cast<uint32_t>(buffer[END + 1]) << 8) | buffer[END + 2]};
+    return CRC == crc24q(buffer, END);
+}
+
+uint32_t RTCM3Frame::crc24q(const uint8_t *data, const size_t &length) noexcept {
+    // One table lookup per byte for the polynomial 0x1864CFB.
+    static const std::array<uint32_t, 256> TABLE = []() {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i{0}; i < 256; i++) {
+            uint32_t crc{i << 16};
+            for (uint32_t bit{0}; bit < 8; bit++) {
+                crc <<= 1;
+                crc ^= ((0 != (crc & 0x1000000)) ? 0x1864CFB : 0);
+            }
+            table[i] = crc & 0xFFFFFF;
+        }
+        return table;
+    }();
+
+    uint32_t crc{0};
+    for (size_t i{0}; i < length; i++) {
+        crc = ((crc << 8) & 0xFFFFFF) ^ TABLE[((crc >> 16) ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RTCM3_FRAME
+#define RTCM3_FRAME
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * RTCM3Frame provides the framing of RTCM 3 correction data: preamble 0xD3,
+ * six reserved zero bits, a 10-bit payload length, the payload, and a 24-bit
+ * CRC-24Q over preamble, length, and payload.
+ */
+class RTCM3Frame {
+   public:
+    enum RTCM3FrameConstants {
+        PREAMBLE           = 0xD3,
+        HEADER_SIZE        = 3,
+        CRC_SIZE           = 3,
+        MAX_PAYLOAD_LENGTH = 1023,
+    };
+
+   public:
+    /**
+     * @param buffer Buffer starting with an RTCM3 frame.
+     * @param size Number of bytes available in the buffer.
+     * @return true if the buffer starts with preamble and reserved bits.
+     */
+    static bool isSync(const uint8_t *buffer, const size_t &size) noexcept {
+        return (2 <= size) && (PREAMBLE == buffer[0]) && (0 == (buffer[1] & 0xFC));
+    }
+
+    /**
+     * @param buffer Buffer starting with preamble and length.
+     * @return Total length of the frame including header and CRC.
+     */
+    static size_t length(const uint8_t *buffer) noexcept {
+        return HEADER_SIZE + ((static_cast<size_t>(buffer[1] & 0x03) << 8) | buffer[2]) + CRC_SIZE;
+    }
+
+    /**
+     * @param buffer Buffer containing a complete frame of the given length.
+     * @param length Total length of the frame.
+     * @return true if the CRC-24Q matches.
+     */
+    static bool isValid(const uint8_t *buffer, const size_t &length) noexcept;
+
+    /**
+     * @param data Data to compute the CRC-24Q for.
+     * @param length Length of the data.
+     * @return CRC-24Q as used by RTCM3 and SBAS.
+     */
+    static uint32_t crc24q(const uint8_t *data, const size_t &length) noexcept;
+};
+
+#endif
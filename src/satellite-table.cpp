@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "satellite-table.hpp"
+
+SatelliteTable::SatelliteTable() noexcept {
+    m_snr.fill(NO_SNR);
+    m_signal.fill(NO_SIGNAL);
+}
+
+SatelliteTable::Constellation SatelliteTable::constellation(const char *talker) noexcept {
+    Constellation retVal{UNKNOWN_CONSTELLATION};
+    if ('G' == talker[0]) {
+        switch (talker[1]) {
+            case 'P': retVal = GPS; break;
+            case 'L': retVal = GLONASS; break;
+            case 'A': retVal = GALILEO; break;
+            case 'B': retVal = BEIDOU; break;
+            case 'Q': retVal = QZSS; break;
+            default: break;
+        }
+    }
+    else if (('B' == talker[0]) && ('D' == talker[1])) {
+        retVal = BEIDOU;
+    }
+    else if (('Q' == talker[0]) && ('Z' == talker[1])) {
+        retVal = QZSS;
+    }
+    return retVal;
+}
+
+SatelliteTable::Constellation SatelliteTable::constellationFromSystemID(const uint32_t &systemID) noexcept {
+    Constellation retVal{UNKNOWN_CONSTELLATION};
+    switch (systemID) {
+        case 1: retVal = GPS; break;
+        case 2: retVal = GLONASS; break;
+        case 3: retVal = GALILEO; break;
+        case 4: retVal = BEIDOU; break;
+        case 5: retVal = QZSS; break;
+        default: break;
+    }
+    return retVal;
+}
+
+bool SatelliteTable::locate(const Constellation &talker, const uint32_t &prn, Constellation &constellation, uint32_t &slot) noexcept {
+    Constellation c{UNKNOWN_CONSTELLATION};
+    uint32_t first{0};
+    // Extended ranges are used regardless of the talker ID.
+    if ((120 <= prn) && (158 >= prn)) {
+        c = SBAS;
+        first = 120;
+    }
+    else if ((193 <= prn) && (202 >= prn) && (BEIDOU != talker)) {
+        c = QZSS;
+        first = 192;
+    }
+    else if ((201 <= prn) && (263 >= prn)) {
+        c = BEIDOU;
+        first = 200;
+    }
+    else if ((301 <= prn) && (336 >= prn)) {
+        c = GALILEO;
+        first = 300;
+    }
+    else if ((401 <= prn) && (463 >= prn)) {
+        c = BEIDOU;
+        first = 400;
+    }
+    // Since NMEA 4.10, Galileo, BeiDou, and QZSS count from 1 with their own talker ID.
+    else if ((GALILEO == talker) || (BEIDOU == talker) || (QZSS == talker)) {
+        const uint32_t LAST{(GALILEO == talker) ? 36u : ((BEIDOU == talker) ? 63u : 10u)};
+        c = ((1 <= prn) && (LAST >= prn)) ? talker : UNKNOWN_CONSTELLATION;
+    }
+    // Some receivers report GLONASS by slot number.
+    else if ((GLONASS == talker) && (1 <= prn) && (32 >= prn)) {
+        c = GLONASS;
+    }
+    // NMEA 2.x ranges; SBAS 33-64 are PRN 120-151.
+    else if ((1 <= prn) && (32 >= prn)) {
+        c = GPS;
+    }
+    else if ((33 <= prn) && (64 >= prn)) {
+        c = SBAS;
+        first = 33;
+    }
+    else if ((65 <= prn) && (96 >= prn)) {
+        c = GLONASS;
+        first = 64;
+    }
+    constellation = c;
+    slot = prn - first;
+    return (UNKNOWN_CONSTELLATION != c);
+}
+
+bool SatelliteTable::beginSentence(const Constellation &talker, const uint32_t &signalID, const uint32_t &sentenceNumber, const uint32_t &numberOfSentences) noexcept {
+    if (NUMBER_OF_CONSTELLATIONS <= talker) {
+        return false;
+    }
+    // Groups of further signals must not overwrite the tracked one.
+    if (signalID < m_signal[talker]) {
+        m_signal[talker] = signalID;
+        m_nextSentence[talker] = 0;
+    }
+    if (signalID != m_signal[talker]) {
+        return false;
+    }
+    if (1 == sentenceNumber) {
+        // The group replaces at least the view of its own constellation.
+        m_receiving[talker] = 0;
+        m_receivingConstellations[talker] = (1u << talker);
+        m_nextSentence[talker] = 1;
+        m_numberOfSentences[talker] = numberOfSentences;
+    }
+    // Drop groups with lost or reordered sentences.
+    const bool IN_SEQUENCE{(0 < sentenceNumber) &&
+                           (sentenceNumber == m_nextSentence[talker]) &&
+                           (numberOfSentences == m_numberOfSentences[talker])};
+    if (!IN_SEQUENCE) {
+        m_nextSentence[talker] = 0;
+    }
+    return IN_SEQUENCE;
+}
+
+void SatelliteTable::add(const Constellation &talker, const uint32_t &prn, const int32_t &elevation, const uint32_t &azimuth, const uint32_t &snr) noexcept {
+    Constellation constellation{UNKNOWN_CONSTELLATION};
+    uint32_t slot{0};
+    if ( (NUMBER_OF_CONSTELLATIONS <= talker) || !locate(talker, prn, constellation, slot) ) {
+        return;
+    }
+    if (0 == (m_receivingConstellations[talker] & (1u << constellation))) {
+        m_receiving[constellation] = 0;
+        m_receivingConstellations[talker] |= (1u << constellation);
+    }
+    const uint32_t INDEX{constellation * SLOTS_PER_CONSTELLATION + slot};
+    m_prn[INDEX] = static_cast<uint16_t>(prn);
+    m_elevation[INDEX] = static_cast<int8_t>(elevation);
+    m_azimuth[INDEX] = static_cast<uint16_t>(azimuth);
+    m_snr[INDEX] = static_cast<uint8_t>((static_cast<uint32_t>(NO_SNR) < snr) ? static_cast<uint32_t>(NO_SNR) : snr);
+    m_receiving[constellation] |= (static_cast<uint64_t>(1) << slot);
+}
+
+uint32_t SatelliteTable::endSentence(const Constellation &talker) noexcept {
+    if (m_nextSentence[talker] != m_numberOfSentences[talker]) {
+        m_nextSentence[talker]++;
+        return 0;
+    }
+    // Constellations no longer reported with this talker are out of view.
+    const uint32_t CHANGED{m_constellations[talker] | m_receivingConstellations[talker]};
+    for (uint32_t c{0}; c < NUMBER_OF_CONSTELLATIONS; c++) {
+        if (0 != (CHANGED & (1u << c))) {
+            m_inView[c] = (0 != (m_receivingConstellations[talker] & (1u << c))) ? m_receiving[c] : 0;
+        }
+    }
+    m_constellations[talker] = m_receivingConstellations[talker];
+    m_nextSentence[talker] = 0;
+    return CHANGED;
+}
+
+void SatelliteTable::setUsed(const Constellation &constellation, const uint64_t &used) noexcept {
+    if (NUMBER_OF_CONSTELLATIONS > constellation) {
+        m_used[constellation] = used;
+    }
+}
+
+void SatelliteTable::clearUsed() noexcept {
+    m_used.fill(0);
+}
+
+uint32_t SatelliteTable::numberOfUsed() const noexcept {
+    uint32_t count{0};
+    for (const uint64_t used : m_used) {
+        count += static_cast<uint32_t>(__builtin_popcountll(used));
+    }
+    return count;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SATELLITE_TABLE
+#define SATELLITE_TABLE
+
+#include <array>
+#include <cstdint>
+
+/**
+ * SatelliteTable holds the satellites in view as reported by GSV groups as
+ * structure of arrays with one array per attribute. Each constellation has
+ * 64 slots; locate() maps the PRN ranges used by NMEA explicitly to their
+ * constellation and slot as SBAS and QZSS satellites are also reported with
+ * the GP talker ID. The table has fixed capacity and is reused across epochs;
+ * a bit mask per constellation marks the slots that were reported by the last
+ * complete GSV group, and another one the slots used in the solution as
+ * reported by the last GSA. NMEA 4.10 and newer report one GSV group per
+ * signal; only the lowest signal ID of each talker is kept to not mix SNRs of
+ * different signals.
+ */
+class SatelliteTable {
+   private:
+    SatelliteTable(const SatelliteTable &) = delete;
+    SatelliteTable(SatelliteTable &&)      = delete;
+    SatelliteTable &operator=(const SatelliteTable &) = delete;
+    SatelliteTable &operator=(SatelliteTable &&) = delete;
+
+   public:
+    enum Constellation {
+        GPS                      = 0,
+        GLONASS                  = 1,
+        GALILEO                  = 2,
+        BEIDOU                   = 3,
+        QZSS                     = 4,
+        SBAS                     = 5,
+        NUMBER_OF_CONSTELLATIONS = 6,
+        UNKNOWN_CONSTELLATION    = 7,
+    };
+
+    enum SatelliteTableConstants {
+        SLOTS_PER_CONSTELLATION = 64,
+        SLOTS                   = SLOTS_PER_CONSTELLATION * NUMBER_OF_CONSTELLATIONS,
+        NO_SNR                  = 0xFF,
+        NO_SIGNAL               = 0xFF,
+    };
+
+   public:
+    SatelliteTable() noexcept;
+
+   public:
+    /**
+     * @param talker Pointer to the two characters of the NMEA talker ID.
+     * @return Constellation for the talker ID.
+     */
+    static Constellation constellation(const char *talker) noexcept;
+
+    /**
+     * @param systemID GNSS system ID as in NMEA 4.10 and newer.
+     * @return Constellation for the system ID.
+     */
+    static Constellation constellationFromSystemID(const uint32_t &systemID) noexcept;
+
+    /**
+     * @param talker Constellation of the talker ID or system ID the PRN was reported with.
+     * @param prn Satellite PRN as used in NMEA.
+     * @param constellation Constellation the satellite belongs to.
+     * @param slot Slot within its constellation.
+     * @return true if the PRN is within a known range.
+     */
+    static bool locate(const Constellation &talker, const uint32_t &prn, Constellation &constellation, uint32_t &slot) noexcept;
+
+    /**
+     * @param talker Constellation of the GSV sentence.
+     * @param signalID Signal ID as in NMEA 4.10 and newer or 0 if absent.
+     * @param sentenceNumber Number of the sentence within the group (1-based).
+     * @param numberOfSentences Number of sentences in the group.
+     * @return true if the sentence continues the current group.
+     */
+    bool beginSentence(const Constellation &talker, const uint32_t &signalID, const uint32_t &sentenceNumber, const uint32_t &numberOfSentences) noexcept;
+
+    void add(const Constellation &talker, const uint32_t &prn, const int32_t &elevation, const uint32_t &azimuth, const uint32_t &snr) noexcept;
+
+    /**
+     * @return Bit mask of the constellations whose view was replaced if the
+     *         group of this talker is complete; 0 otherwise.
+     */
+    uint32_t endSentence(const Constellation &talker) noexcept;
+
+    /**
+     * @param constellation Constellation of the GSA sentence.
+     * @param used Slots of the satellites used in the solution.
+     */
+    void setUsed(const Constellation &constellation, const uint64_t &used) noexcept;
+
+    /**
+     * Discards the satellites used in the solution of all constellations.
+     */
+    void clearUsed() noexcept;
+
+   public:
+    uint64_t inView(const Constellation &constellation) const noexcept {
+        return m_inView[constellation];
+    }
+
+    uint64_t used(const Constellation &constellation) const noexcept {
+        return m_used[constellation];
+    }
+
+    /**
+     * @return Slots used in the solution for which azimuth, elevation, and SNR are known.
+     */
+    uint64_t usedInView(const Constellation &constellation) const noexcept {
+        return m_used[constellation] & m_inView[constellation];
+    }
+
+    /**
+     * @return Number of satellites used in the solution over all constellations.
+     */
+    uint32_t numberOfUsed() const noexcept;
+
+    uint32_t prn(const Constellation &constellation, const uint32_t &slot) const noexcept {
+        return m_prn[constellation * SLOTS_PER_CONSTELLATION + slot];
+    }
+
+    /**
+     * @return Elevation in degrees.
+     */
+    int32_t elevation(const Constellation &constellation, const uint32_t &slot) const noexcept {
+        return m_elevation[constellation * SLOTS_PER_CONSTELLATION + slot];
+    }
+
+    /**
+     * @return Azimuth in degrees from true north.
+     */
+    uint32_t azimuth(const Constellation &constellation, const uint32_t &slot) const noexcept {
+        return m_azimuth[constellation * SLOTS_PER_CONSTELLATION + slot];
+    }
+
+    /**
+     * @return SNR in dB-Hz or NO_SNR if not tracked.
+     */
+    uint32_t snr(const Constellation &constellation, const uint32_t &slot) const noexcept {
+        return m_snr[constellation * SLOTS_PER_CONSTELLATION + slot];
+    }
+
+   private:
+    std::array<uint16_t, SLOTS> m_prn{};
+    std::array<int8_t, SLOTS> m_elevation{};
+    std::array<uint16_t, SLOTS> m_azimuth{};
+    std::array<uint8_t, SLOTS> m_snr{};
+
+    // Slots of the last complete group and of the group being received.
+    std::array<uint64_t, NUMBER_OF_CONSTELLATIONS> m_inView{};
+    std::array<uint64_t, NUMBER_OF_CONSTELLATIONS> m_receiving{};
+    std::array<uint64_t, NUMBER_OF_CONSTELLATIONS> m_used{};
+
+    // Group state per talker: tracked signal, sequence, and the
+    // constellations fed by the group being received and the last one.
+    std::array<uint32_t, NUMBER_OF_CONSTELLATIONS> m_signal{};
+    std::array<uint32_t, NUMBER_OF_CONSTELLATIONS> m_nextSentence{};
+    std::array<uint32_t, NUMBER_OF_CONSTELLATIONS> m_numberOfSentences{};
+    std::array<uint32_t, NUMBER_OF_CONSTELLATIONS> m_receivingConstellations{};
+    std::array<uint32_t, NUMBER_OF_CONSTELLATIONS> m_constellations{};
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stationary-detector.hpp"
+
+#include <cmath>
+
+namespace {
+    // Time for which the vehicle has to stand still before being stationary.
+    constexpr double HOLD_TIME{3.0};                    /*s*/
+    // Factors on the limits from which on a stationary vehicle is moving.
+    constexpr double MOVING_SPEED_FACTOR{2.5};
+    constexpr double MOVING_DEVIATION_FACTOR{2.0};
+    constexpr double MOVING_DISTANCE_FACTOR{3.0};
+    // Age after which the speed is unknown, e.g., for units without RMC.
+    constexpr double MAX_SPEED_AGE{2.0};                /*s*/
+    constexpr double MAX_GAP{2.0};                      /*s*/
+    // A vehicle this far from the reference is moving anyway.
+    constexpr double MAX_DISTANCE_TO_REFERENCE{100.0};  /*m*/
+}
+
+StationaryDetector::StationaryDetector(const double &maxSpeed, const double &maxDeviation) noexcept
+    : m_maxSpeed(maxSpeed)
+    , m_maxDeviation(maxDeviation) {
+}
+
+void StationaryDetector::reset() noexcept {
+    m_isStationary = false;
+    m_isStill = false;
+    m_frame.reset();
+    m_count = 0;
+    m_next = 0;
+    m_sum.fill(0.0);
+    m_sumSquares.fill(0.0);
+}
+
+bool StationaryDetector::hasSpeed(const std::chrono::system_clock::time_point &tp) const noexcept {
+    return std::fabs(std::chrono::duration<double>(tp - m_speedTime).count()) <= MAX_SPEED_AGE;
+}
+
+void StationaryDetector::setSpeed(const float &speed, const std::chrono::system_clock::time_point &tp) noexcept {
+    m_speed = static_cast<double>(speed);
+    m_speedTime = tp;
+    if (m_maxSpeed < m_speed) {
+        m_isStill = false;
+        if (MOVING_SPEED_FACTOR * m_maxSpeed < m_speed) {
+            m_isStationary = false;
+        }
+    }
+}
+
+void StationaryDetector::setPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept {
+    double gap{0.0};
+    if (!m_frame.nextEpoch(tp, gap)) {
+        return;
+    }
+    if ((0.0 > gap) || (MAX_GAP < gap)) {
+        reset();
+    }
+    if (!m_frame.hasReference()) {
+        m_frame.setReference(latitude, longitude);
+    }
+    std::array<double, 2> sample{m_frame.toLocal(latitude, longitude)};
+    if (MAX_DISTANCE_TO_REFERENCE < std::hypot(sample[EAST], sample[NORTH])) {
+        reset();
+        m_frame.setReference(latitude, longitude);
+        sample = std::array<double, 2>{{0.0, 0.0}};
+    }
+
+    if (WINDOW == m_count) {
+        for (uint32_t i{0}; i < 2; i++) {
+            m_sum[i] -= m_samples[m_next][i];
+            m_sumSquares[i] -= m_samples[m_next][i] * m_samples[m_next][i];
+        }
+    }
+    else {
+        m_count++;
+    }
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % WINDOW;
+    for (uint32_t i{0}; i < 2; i++) {
+        m_sum[i] += sample[i];
+        m_sumSquares[i] += sample[i] * sample[i];
+    }
+    if (WINDOW > m_count) {
+        return;
+    }
+
+    const double N{static_cast<double>(WINDOW)};
+    const std::array<double, 2> MEAN{{m_sum[EAST] / N, m_sum[NORTH] / N}};
+    const double VARIANCE{std::fmax(m_sumSquares[EAST] / N - MEAN[EAST] * MEAN[EAST] + m_sumSquares[NORTH] / N - MEAN[NORTH] * MEAN[NORTH], 0.0)};
+    const bool HAS_SPEED{hasSpeed(tp)};
+
+    if (m_isStationary) {
+        const double MAX_VARIANCE{MOVING_DEVIATION_FACTOR * MOVING_DEVIATION_FACTOR * m_maxDeviation * m_maxDeviation};
+        const double MAX_DISTANCE{MOVING_DISTANCE_FACTOR * m_maxDeviation};
+        if ((MAX_VARIANCE < VARIANCE) || (MAX_DISTANCE < std::hypot(sample[EAST] - m_stop[EAST], sample[NORTH] - m_stop[NORTH]))) {
+            m_isStationary = false;
+            m_isStill = false;
+        }
+        return;
+    }
+
+    if ((m_maxDeviation * m_maxDeviation < VARIANCE) || (HAS_SPEED && (m_maxSpeed < m_speed))) {
+        m_isStill = false;
+        return;
+    }
+    if (!m_isStill) {
+        m_isStill = true;
+        m_stillSince = tp;
+    }
+    if (HOLD_TIME <= std::chrono::duration<double>(tp - m_stillSince).count()) {
+        m_isStationary = true;
+        m_stop = MEAN;
+    }
+}
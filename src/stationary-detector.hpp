@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATIONARY_DETECTOR
+#define STATIONARY_DETECTOR
+
+#include "local-frame.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * StationaryDetector tells whether the vehicle stands still from the ground
+ * speed and the spread of the last positions in a local frame, whose running
+ * sums are updated in constant time per position. The vehicle is considered
+ * stationary after both have been below their limits for a few seconds, and
+ * moving again as soon as the speed, the spread, or the distance from where it
+ * stopped clearly exceeds them; the gap in between avoids flapping.
+ */
+class StationaryDetector {
+   private:
+    StationaryDetector(const StationaryDetector &) = delete;
+    StationaryDetector(StationaryDetector &&)      = delete;
+    StationaryDetector &operator=(const StationaryDetector &) = delete;
+    StationaryDetector &operator=(StationaryDetector &&) = delete;
+
+   public:
+    /**
+     * @param maxSpeed Speed in m/s below which the vehicle may be stationary.
+     * @param maxDeviation Standard deviation of the positions in meters below which the vehicle may be stationary.
+     */
+    explicit StationaryDetector(const double &maxSpeed = 0.2, const double &maxDeviation = 1.0) noexcept;
+
+   public:
+    /**
+     * @param speed Ground speed in m/s.
+     * @param tp Time point of the speed.
+     */
+    void setSpeed(const float &speed, const std::chrono::system_clock::time_point &tp) noexcept;
+
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param tp Time point of the position.
+     */
+    void setPosition(const double &latitude, const double &longitude, const std::chrono::system_clock::time_point &tp) noexcept;
+
+    /**
+     * @return true while the vehicle is stationary; may be called from another
+     *         thread, e.g., the prediction thread.
+     */
+    bool isStationary() const noexcept {
+        return m_isStationary.load();
+    }
+
+   private:
+    enum : uint32_t { WINDOW = 10 };
+    enum Samples { EAST = 0, NORTH = 1 };
+
+   private:
+    void reset() noexcept;
+    bool hasSpeed(const std::chrono::system_clock::time_point &tp) const noexcept;
+
+   private:
+    const double m_maxSpeed;
+    const double m_maxDeviation;
+
+    std::atomic<bool> m_isStationary{false};
+    bool m_isStill{false};
+    std::chrono::system_clock::time_point m_stillSince{};
+    std::array<double, 2> m_stop{};
+
+    double m_speed{0.0};
+    std::chrono::system_clock::time_point m_speedTime{};
+
+    LocalFrame m_frame{};
+
+    // Ring buffer of east and north relative to the reference.
+    std::array<std::array<double, 2>, WINDOW> m_samples{};
+    uint32_t m_count{0};
+    uint32_t m_next{0};
+
+    std::array<double, 2> m_sum{};
+    std::array<double, 2> m_sumSquares{};
+};
+
+#endif
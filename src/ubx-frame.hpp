@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UBX_FRAME
+#define UBX_FRAME
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * UBXFrame provides the framing of u-blox' binary UBX protocol:
+ * 0xB5 0x62, class, ID, little-endian payload length, payload, and a
+ * two-byte Fletcher checksum over class, ID, length, and payload.
+ */
+class UBXFrame {
+   public:
+    enum UBXFrameConstants {
+        SYNC_CHAR_1     = 0xB5,
+        SYNC_CHAR_2     = 0x62,
+        HEADER_SIZE     = 6,
+        CHECKSUM_SIZE   = 2,
+        CLASS_NAV       = 0x01,
+        ID_NAV_PVT      = 0x07,
+        NAV_PVT_LENGTH  = 92,
+    };
+
+   public:
+    /**
+     * @param buffer Buffer starting with a UBX frame.
+     * @param size Number of bytes available in the buffer.
+     * @return true if the buffer starts with the UBX sync characters.
+     */
+    static bool isSync(const uint8_t *buffer, const size_t &size) noexcept {
+        return (2 <= size) && (SYNC_CHAR_1 == buffer[0]) && (SYNC_CHAR_2 == buffer[1]);
+    }
+
+    /**
+     * @param buffer Buffer starting with the UBX sync characters.
+     * @return Total length of the frame including header and checksum.
+     */
+    static size_t length(const uint8_t *buffer) noexcept {
+        return HEADER_SIZE + load<uint16_t>(buffer + 4) + CHECKSUM_SIZE;
+    }
+
+    /**
+     * @param buffer Buffer containing a complete frame of the given length.
+     * @param length Total length of the frame.
+     * @return true if the Fletcher checksum matches.
+     */
+    static bool isValid(const uint8_t *buffer, const size_t &length) noexcept {
+        uint8_t a{0};
+        uint8_t b{0};
+        for (size_t i{2}; i < (length - CHECKSUM_SIZE); i++) {
+            a = static_cast<uint8_t>(a + buffer[i]);
+            b = static_cast<uint8_t>(b + a);
+        }
+        return (a == buffer[length - 2]) && (b == buffer[length - 1]);
+    }
+
+    /**
+     * @return Little-endian value of type T at the given address.
+     */
+    template <typename T>
+    static T load(const uint8_t *p) noexcept {
+        uint64_t tmp{0};
+        for (size_t i{sizeof(T)}; 0 < i; i--) {
+            tmp = (tmp << 8) | p[i - 1];
+        }
+        return static_cast<T>(tmp);
+    }
+};
+
+#endif
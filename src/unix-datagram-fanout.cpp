@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unix-datagram-fanout.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+UNIXDatagramFanOut::UNIXDatagramFanOut(const std::string &path) noexcept
+    : m_path(path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if ( m_path.empty() || (m_path.size() >= sizeof(address.sun_path)) ) {
+        return;
+    }
+    // A leading '@' denotes the abstract namespace.
+    const bool IS_ABSTRACT{'@' == m_path[0]};
+    std::memcpy(address.sun_path, m_path.data(), m_path.size());
+    if (IS_ABSTRACT) {
+        address.sun_path[0] = '\0';
+    }
+    const socklen_t LENGTH{static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + m_path.size() + (IS_ABSTRACT ? 0 : 1))};
+
+    // Only a stale socket left behind by a previous run may be replaced;
+    // any other existing file is kept and binding fails.
+    if (!IS_ABSTRACT) {
+        struct stat status;
+        if (0 == ::lstat(m_path.c_str(), &status)) {
+            if (!S_ISSOCK(status.st_mode)) {
+                m_path.clear();
+                return;
+            }
+            ::unlink(m_path.c_str());
+        }
+    }
+
+    m_socket = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (0 > m_socket) {
+        return;
+    }
+    if ( (0 != ::fcntl(m_socket, F_SETFL, ::fcntl(m_socket, F_GETFL, 0) | O_NONBLOCK)) ||
+         (0 != ::bind(m_socket, reinterpret_cast<sockaddr*>(&address), LENGTH)) ) {
+        ::close(m_socket);
+        m_socket = -1;
+        return;
+    }
+    if (IS_ABSTRACT) {
+        m_path.clear();
+    }
+}
+
+UNIXDatagramFanOut::~UNIXDatagramFanOut() {
+    if (0 <= m_socket) {
+        ::close(m_socket);
+        m_socket = -1;
+        if (!m_path.empty()) {
+            ::unlink(m_path.c_str());
+        }
+    }
+}
+
+bool UNIXDatagramFanOut::isRunning() const noexcept {
+    return (0 <= m_socket);
+}
+
+uint32_t UNIXDatagramFanOut::numberOfReaders() const noexcept {
+    return m_numberOfReaders;
+}
+
+uint64_t UNIXDatagramFanOut::droppedDatagrams() const noexcept {
+    return m_droppedDatagrams;
+}
+
+void UNIXDatagramFanOut::send(const char *data, const size_t &length) noexcept {
+    if (0 > m_socket) {
+        return;
+    }
+    acceptReaders();
+
+    for (uint32_t i{0}; i < m_numberOfReaders;) {
+        const ssize_t sent = ::sendto(m_socket, data, length, MSG_DONTWAIT | MSG_NOSIGNAL,
+                                      reinterpret_cast<const sockaddr*>(&m_readers[i].address), m_readers[i].length);
+        if ( (0 > sent) && ((ECONNREFUSED == errno) || (ENOENT == errno) || (ENOTCONN == errno)) ) {
+            // Reader went away; the last reader takes its slot.
+            detachReader(i);
+            continue;
+        }
+        if (0 > sent) {
+            // Reader is too slow (EAGAIN/ENOBUFS); drop this datagram for it.
+            m_droppedDatagrams++;
+        }
+        i++;
+    }
+}
+
+void UNIXDatagramFanOut::acceptReaders() noexcept {
+    char buffer[64];
+    Reader reader;
+    while (true) {
+        std::memset(&reader.address, 0, sizeof(reader.address));
+        reader.length = sizeof(reader.address);
+        const ssize_t received = ::recvfrom(m_socket, buffer, sizeof(buffer), MSG_DONTWAIT,
+                                            reinterpret_cast<sockaddr*>(&reader.address), &reader.length);
+        if (0 > received) {
+            break;
+        }
+        // Unbound readers cannot receive anything.
+        if (reader.length <= static_cast<socklen_t>(offsetof(sockaddr_un, sun_path))) {
+            continue;
+        }
+        bool isKnown{false};
+        for (uint32_t i{0}; (i < m_numberOfReaders) && !isKnown; i++) {
+            isKnown = (m_readers[i].length == reader.length) && (0 == std::memcmp(&m_readers[i].address, &reader.address, reader.length));
+        }
+        if (!isKnown && (m_numberOfReaders < MAX_READERS)) {
+            m_readers[m_numberOfReaders++] = reader;
+        }
+    }
+}
+
+void UNIXDatagramFanOut::detachReader(const uint32_t &index) noexcept {
+    m_numberOfReaders--;
+    m_readers[index] = m_readers[m_numberOfReaders];
+}
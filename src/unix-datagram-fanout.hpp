@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UNIX_DATAGRAM_FANOUT
+#define UNIX_DATAGRAM_FANOUT
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * UNIXDatagramFanOut binds a UNIX domain datagram socket to a given path (or
+ * to the abstract namespace if the path starts with '@'). Local readers attach
+ * by sending any datagram from their own bound socket; afterwards, every
+ * datagram passed to send() is forwarded to all attached readers. Sending
+ * never blocks: if a reader's receive queue is full, the datagram is dropped
+ * for this reader; readers that went away are detached. An existing file at
+ * the path is only replaced if it is a socket.
+ */
+class UNIXDatagramFanOut {
+   private:
+    UNIXDatagramFanOut(const UNIXDatagramFanOut &) = delete;
+    UNIXDatagramFanOut(UNIXDatagramFanOut &&)      = delete;
+    UNIXDatagramFanOut &operator=(const UNIXDatagramFanOut &) = delete;
+    UNIXDatagramFanOut &operator=(UNIXDatagramFanOut &&) = delete;
+
+   public:
+    enum UNIXDatagramFanOutConstants {
+        MAX_READERS = 16,
+    };
+
+   public:
+    UNIXDatagramFanOut(const std::string &path) noexcept;
+    ~UNIXDatagramFanOut();
+
+   public:
+    bool isRunning() const noexcept;
+    uint32_t numberOfReaders() const noexcept;
+    uint64_t droppedDatagrams() const noexcept;
+    void send(const char *data, const size_t &length) noexcept;
+
+   private:
+    void acceptReaders() noexcept;
+    void detachReader(const uint32_t &index) noexcept;
+
+   private:
+    struct Reader {
+        sockaddr_un address;
+        socklen_t length;
+    };
+
+    int32_t m_socket{-1};
+    std::string m_path{};
+    std::array<Reader, MAX_READERS> m_readers{};
+    uint32_t m_numberOfReaders{0};
+    uint64_t m_droppedDatagrams{0};
+};
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "polynomial-kernels.hpp"
+#include "utm-projection.hpp"
+#include "wgs84.hpp"
+
+#include <cmath>
+
+namespace {
+    constexpr double DEG2RAD{M_PI / 180.0};
+    constexpr double SCALE{0.9996};
+    constexpr double FALSE_EASTING{500000.0};
+    constexpr double FALSE_NORTHING_SOUTH{10000000.0};
+
+    // atan(w) for |w| below 0.04; the truncation error is below 1e-20.
+    inline double smallAtan(const double &w) noexcept {
+        const double W2{w * w};
+        return w * (1.0 + W2 * (-1.0 / 3.0 + W2 * (1.0 / 5.0 + W2 * (-1.0 / 7.0 + W2 * (1.0 / 9.0 + W2 * (-1.0 / 11.0))))));
+    }
+
+    // atanh(u) for |u| below sin(20 degrees); the truncation error is below
+    // 1e-18.
+    inline double smallAtanh(const double &u) noexcept {
+        const double U2{u * u};
+        double sum{1.0 / 33.0};
+        for (int32_t k{15}; k >= 0; k--) {
+            sum = 1.0 / static_cast<double>(2 * k + 1) + U2 * sum;
+        }
+        return u * sum;
+    }
+
+    inline void project(const double &latitude, const double &longitude, const double &centralMeridian, const double &eccentricity, const double &scaledRadius, const double &falseNorthing, const std::array<double, 6> &alpha, double &easting, double &northing) noexcept {
+        // Conformal latitude and spherical transverse Mercator.
+        const double S{std::sin(latitude * DEG2RAD)};
+        const double T{std::sinh(std::atanh(S) - eccentricity * std::atanh(eccentricity * S))};
+        const double L{std::remainder(longitude * DEG2RAD - centralMeridian, 2.0 * M_PI)};
+        const double XI{std::atan2(T, std::cos(L))};
+        const double ETA{std::atanh(std::sin(L) / std::sqrt(1.0 + T * T))};
+
+        // Sum alpha_j * sin(2j * (XI + i * ETA)) with Clenshaw's recurrence
+        // on complex numbers; only sin(2 * zeta) and cos(2 * zeta) are needed.
+        const double SIN_XI{std::sin(2.0 * XI)};
+        const double COS_XI{std::cos(2.0 * XI)};
+        const double EXP_ETA{std::exp(2.0 * ETA)};
+        const double SINH_ETA{0.5 * (EXP_ETA - 1.0 / EXP_ETA)};
+        const double COSH_ETA{0.5 * (EXP_ETA + 1.0 / EXP_ETA)};
+        const double COS_RE{2.0 * COS_XI * COSH_ETA};
+        const double COS_IM{-2.0 * SIN_XI * SINH_ETA};
+        double b1Re{0.0};
+        double b1Im{0.0};
+        double b2Re{0.0};
+        double b2Im{0.0};
+        for (int32_t j{5}; j >= 0; j--) {
+            const double RE{alpha[static_cast<size_t>(j)] + COS_RE * b1Re - COS_IM * b1Im - b2Re};
+            const double IM{COS_RE * b1Im + COS_IM * b1Re - b2Im};
+            b2Re = b1Re;
+            b2Im = b1Im;
+            b1Re = RE;
+            b1Im = IM;
+        }
+        const double SIN_RE{SIN_XI * COSH_ETA};
+        const double SIN_IM{COS_XI * SINH_ETA};
+        easting = FALSE_EASTING + scaledRadius * (ETA + b1Re * SIN_IM + b1Im * SIN_RE);
+        northing = falseNorthing + scaledRadius * (XI + b1Re * SIN_RE - b1Im * SIN_IM);
+    }
+}
+
+UTMProjection::UTMProjection(const uint32_t &zone, const bool &isNorth) noexcept
+    : m_zone((0 == zone) ? 60 : ((zone - 1) % 60) + 1)
+    , m_isNorth(isNorth)
+    , m_centralMeridian((static_cast<double>(m_zone) * 6.0 - 183.0) * DEG2RAD)
+    , m_falseNorthing(isNorth ? 0.0 : FALSE_NORTHING_SOUTH)
+    , m_eccentricity(std::sqrt(WGS84::E2))
+    , m_scaledRadius(0.0) {
+    // Rectifying radius and Krüger's coefficients in the third flattening n.
+    const double N{WGS84::F / (2.0 - WGS84::F)};
+    const double N2{N * N};
+    const double N3{N2 * N};
+    const double N4{N3 * N};
+    const double N5{N4 * N};
+    const double N6{N5 * N};
+    m_scaledRadius = SCALE * WGS84::A / (1.0 + N) * (1.0 + N2 / 4.0 + N4 / 64.0 + N6 / 256.0);
+    m_alpha[0] = N / 2.0 - 2.0 * N2 / 3.0 + 5.0 * N3 / 16.0 + 41.0 * N4 / 180.0 - 127.0 * N5 / 288.0 + 7891.0 * N6 / 37800.0;
+    m_alpha[1] = 13.0 * N2 / 48.0 - 3.0 * N3 / 5.0 + 557.0 * N4 / 1440.0 + 281.0 * N5 / 630.0 - 1983433.0 * N6 / 1935360.0;
+    m_alpha[2] = 61.0 * N3 / 240.0 - 103.0 * N4 / 140.0 + 15061.0 * N5 / 26880.0 + 167603.0 * N6 / 181440.0;
+    m_alpha[3] = 49561.0 * N4 / 161280.0 - 179.0 * N5 / 168.0 + 6601661.0 * N6 / 7257600.0;
+    m_alpha[4] = 34729.0 * N5 / 80640.0 - 3418889.0 * N6 / 1995840.0;
+    m_alpha[5] = 212378941.0 * N6 / 319334400.0;
+
+    // Series of the conformal latitude chi = phi + sum chi_j * sin(2j * phi).
+    m_chi[0] = -2.0 * N + 2.0 * N2 / 3.0 + 4.0 * N3 / 3.0 - 82.0 * N4 / 45.0 + 32.0 * N5 / 45.0 + 4642.0 * N6 / 4725.0;
+    m_chi[1] = 5.0 * N2 / 3.0 - 16.0 * N3 / 15.0 - 13.0 * N4 / 9.0 + 904.0 * N5 / 315.0 - 1522.0 * N6 / 945.0;
+    m_chi[2] = -26.0 * N3 / 15.0 + 34.0 * N4 / 21.0 + 8.0 * N5 / 5.0 - 12686.0 * N6 / 2835.0;
+    m_chi[3] = 1237.0 * N4 / 630.0 - 12.0 * N5 / 5.0 - 24832.0 * N6 / 14175.0;
+    m_chi[4] = -734.0 * N5 / 315.0 + 109598.0 * N6 / 31185.0;
+    m_chi[5] = 444337.0 * N6 / 155925.0;
+}
+
+uint32_t UTMProjection::zone(const double &latitude, const double &longitude) noexcept {
+    const double LONGITUDE{std::remainder(longitude, 360.0)};
+    if ( (56.0 <= latitude) && (64.0 > latitude) && (3.0 <= LONGITUDE) && (12.0 > LONGITUDE) ) {
+        return 32;
+    }
+    if ( (72.0 <= latitude) && (0.0 <= LONGITUDE) && (42.0 > LONGITUDE) ) {
+        return (9.0 > LONGITUDE) ? 31 : ((21.0 > LONGITUDE) ? 33 : ((33.0 > LONGITUDE) ? 35 : 37));
+    }
+    const uint32_t ZONE{static_cast<uint32_t>(std::floor((LONGITUDE + 180.0) / 6.0)) + 1};
+    return (60 < ZONE) ? 1 : ZONE;
+}
+
+void UTMProjection::toUTM(const double &latitude, const double &longitude, double &easting, double &northing) const noexcept {
+    project(latitude, longitude, m_centralMeridian, m_eccentricity, m_scaledRadius, m_falseNorthing, m_alpha, easting, northing);
+}
+
+void UTMProjection::toUTM(const double *__restrict__ latitude, const double *__restrict__ longitude, double *__restrict__ easting, double *__restrict__ northing, const size_t &count) const noexcept {
+    // Copies of the members let the compiler keep them in registers.
+    const double CENTRAL_MERIDIAN{m_centralMeridian};
+    const double SCALED_RADIUS{m_scaledRadius};
+    const double FALSE_NORTHING{m_falseNorthing};
+    const std::array<double, 6> ALPHA(m_alpha);
+    const std::array<double, 6> CHI(m_chi);
+    const size_t COUNT{count};
+    for (size_t i{0}; i < COUNT; i++) {
+        // Conformal latitude from its series, summed with Clenshaw's
+        // recurrence on sin(2 * phi) and cos(2 * phi).
+        const double PHI{latitude[i] * DEG2RAD};
+        double sinPhi{0.0};
+        double cosPhi{1.0};
+        PolynomialKernels::sinCos(2.0 * PHI, sinPhi, cosPhi);
+        double c1{0.0};
+        double c2{0.0};
+        for (int32_t j{5}; j >= 0; j--) {
+            const double C{CHI[static_cast<size_t>(j)] + 2.0 * cosPhi * c1 - c2};
+            c2 = c1;
+            c1 = C;
+        }
+        const double CHI_I{PHI + c1 * sinPhi};
+        double sinChi{0.0};
+        double cosChi{1.0};
+        PolynomialKernels::sinCos(CHI_I, sinChi, cosChi);
+        double sinL{0.0};
+        double cosL{1.0};
+        PolynomialKernels::sinCos(PolynomialKernels::wrapAngle(longitude[i] * DEG2RAD - CENTRAL_MERIDIAN), sinL, cosL);
+
+        // With tan(XI) = P / Q and tanh(ETA) = U, where 1 - U^2 = P^2 + Q^2,
+        // the double angle functions are rational in P, Q, and U. XI is the
+        // conformal latitude plus a small correction and ETA is small.
+        const double P{sinChi};
+        const double Q{cosChi * cosL};
+        const double U{cosChi * sinL};
+        const double D{1.0 / (1.0 - U * U)};
+        const double SIN_XI{2.0 * P * Q * D};
+        const double COS_XI{(Q * Q - P * P) * D};
+        const double SINH_ETA{2.0 * U * D};
+        const double COSH_ETA{(1.0 + U * U) * D};
+        const double XI{CHI_I + smallAtan(sinChi * cosChi * (1.0 - cosL) / (sinChi * P + cosChi * Q))};
+        const double ETA{smallAtanh(U)};
+
+        const double COS_RE{2.0 * COS_XI * COSH_ETA};
+        const double COS_IM{-2.0 * SIN_XI * SINH_ETA};
+        double b1Re{0.0};
+        double b1Im{0.0};
+        double b2Re{0.0};
+        double b2Im{0.0};
+        for (int32_t j{5}; j >= 0; j--) {
+            const double RE{ALPHA[static_cast<size_t>(j)] + COS_RE * b1Re - COS_IM * b1Im - b2Re};
+            const double IM{COS_RE * b1Im + COS_IM * b1Re - b2Im};
+            b2Re = b1Re;
+            b2Im = b1Im;
+            b1Re = RE;
+            b1Im = IM;
+        }
+        const double SIN_RE{SIN_XI * COSH_ETA};
+        const double SIN_IM{COS_XI * SINH_ETA};
+        easting[i] = FALSE_EASTING + SCALED_RADIUS * (ETA + b1Re * SIN_IM + b1Im * SIN_RE);
+        northing[i] = FALSE_NORTHING + SCALED_RADIUS * (XI + b1Re * SIN_RE - b1Im * SIN_IM);
+    }
+}
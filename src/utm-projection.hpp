@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTM_PROJECTION
+#define UTM_PROJECTION
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * UTMProjection converts WGS84 positions into easting and northing of one UTM
+ * zone using Krüger's series to sixth order in the third flattening, which
+ * is accurate to well below a millimeter within the zone. The series
+ * coefficients and the zone's central meridian are computed once per
+ * projection; per position, the series is summed with Clenshaw's recurrence
+ * so only a handful of transcendental functions are evaluated. The batch
+ * conversion replaces these by polynomial kernels.
+ */
+class UTMProjection {
+   private:
+    UTMProjection(const UTMProjection &) = delete;
+    UTMProjection(UTMProjection &&)      = delete;
+    UTMProjection &operator=(const UTMProjection &) = delete;
+    UTMProjection &operator=(UTMProjection &&) = delete;
+
+   public:
+    /**
+     * @param zone UTM zone from 1 to 60; other values are wrapped.
+     * @param isNorth true for the northern hemisphere.
+     */
+    UTMProjection(const uint32_t &zone, const bool &isNorth) noexcept;
+
+   public:
+    /**
+     * @return UTM zone of the given position including the exceptions for
+     *         Norway and Svalbard.
+     */
+    static uint32_t zone(const double &latitude, const double &longitude) noexcept;
+
+    uint32_t zone() const noexcept {
+        return m_zone;
+    }
+
+    bool isNorth() const noexcept {
+        return m_isNorth;
+    }
+
+    /**
+     * @param latitude Latitude in degrees.
+     * @param longitude Longitude in degrees.
+     * @param easting Easting in meters.
+     * @param northing Northing in meters.
+     */
+    void toUTM(const double &latitude, const double &longitude, double &easting, double &northing) const noexcept;
+
+    /**
+     * Converts count positions given as structure of arrays, e.g., from a
+     * replayed log. The conformal latitude is summed from its series in the
+     * third flattening and the remaining functions are evaluated by
+     * polynomial kernels, so the loop has neither branches nor library calls
+     * and the compiler can process several positions per SIMD register
+     * (e.g., with -O3). Positions must be within 20 degrees of the zone's
+     * central meridian, where the results stay within 0.1 micrometers of the
+     * scalar conversion. The arrays must not overlap.
+     */
+    void toUTM(const double *__restrict__ latitude, const double *__restrict__ longitude, double *__restrict__ easting, double *__restrict__ northing, const size_t &count) const noexcept;
+
+   private:
+    uint32_t m_zone;
+    bool m_isNorth;
+    double m_centralMeridian;
+    double m_falseNorthing;
+    double m_eccentricity;
+    double m_scaledRadius;
+    std::array<double, 6> m_alpha{};
+    std::array<double, 6> m_chi{};
+};
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WGS84_HPP
+#define WGS84_HPP
+
+#include <array>
+#include <cmath>
+
+/**
+ * Parameters of the WGS84 ellipsoid.
+ */
+namespace WGS84 {
+    constexpr double A{6378137.0};              /*semi-major axis in meters*/
+    constexpr double F{1.0 / 298.257223563};    /*flattening*/
+    constexpr double E2{F * (2.0 - F)};         /*first eccentricity squared*/
+
+    /**
+     * @param latitude Latitude in degrees.
+     * @return Meters per degree of latitude and of longitude at the given
+     *         latitude from the meridian and prime vertical radii of curvature.
+     */
+    inline std::array<double, 2> metersPerDegree(const double &latitude) noexcept {
+        constexpr double DEG2RAD{M_PI / 180.0};
+        const double SIN_LATITUDE{std::sin(latitude * DEG2RAD)};
+        const double W{1.0 - E2 * SIN_LATITUDE * SIN_LATITUDE};
+        return std::array<double, 2>{{DEG2RAD * A * (1.0 - E2) / (W * std::sqrt(W)),
+                                      DEG2RAD * A * std::cos(latitude * DEG2RAD) / std::sqrt(W)}};
+    }
+}
+
+#endif
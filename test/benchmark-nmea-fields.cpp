@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nmea-fields.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Compares NMEAFields::toDouble with a per-character loop and std::stod on
+// typical GGA fields; build in Release mode to get meaningful numbers.
+int32_t main(int32_t, char **) {
+    const std::string DATA{"$GPGGA,172814.0,3723.46587704,12202.26957864,0.14,18.893"};
+    NMEAFields f;
+    f.tokenize(reinterpret_cast<const uint8_t*>(DATA.data()), DATA.size());
+    std::vector<std::string> fields;
+    for (size_t i{1}; i < f.size(); i++) {
+        fields.push_back(std::string(f.data(i), f.length(i)));
+    }
+
+    constexpr int32_t ITERATIONS{1000000};
+    constexpr double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10};
+    // The checksum keeps the optimizer from dropping the loops.
+    volatile double sum{0.0};
+    const auto T0{std::chrono::steady_clock::now()};
+    for (int32_t i{0}; i < ITERATIONS; i++) {
+        for (size_t j{1}; j < f.size(); j++) {
+            double v{0.0};
+            f.toDouble(j, v);
+            sum = sum + v;
+        }
+    }
+    const auto T1{std::chrono::steady_clock::now()};
+    for (int32_t i{0}; i < ITERATIONS; i++) {
+        for (size_t j{1}; j < f.size(); j++) {
+            const char *c{f.data(j)};
+            const char *end{c + f.length(j)};
+            uint64_t mantissa{0};
+            int32_t decimals{-1};
+            for (; c < end; c++) {
+                if (('.' == *c) && (0 > decimals)) {
+                    decimals = 0;
+                    continue;
+                }
+                const uint32_t d{static_cast<uint32_t>(*c - '0')};
+                if (9 < d) {
+                    break;
+                }
+                mantissa = mantissa * 10 + d;
+                decimals += ((0 <= decimals) ? 1 : 0);
+            }
+            sum = sum - static_cast<double>(mantissa) / POW10[(0 < decimals) ? decimals : 0];
+        }
+    }
+    const auto T2{std::chrono::steady_clock::now()};
+    for (int32_t i{0}; i < ITERATIONS; i++) {
+        for (const auto &field : fields) {
+            sum = sum + std::stod(field);
+        }
+    }
+    const auto T3{std::chrono::steady_clock::now()};
+
+    auto ns = [&fields](const std::chrono::steady_clock::duration &d) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) / (ITERATIONS * static_cast<double>(fields.size()));
+    };
+    std::cout << "NMEAFields::toDouble: " << ns(T1 - T0) << " ns/field" << std::endl
+              << "per-character loop:   " << ns(T2 - T1) << " ns/field" << std::endl
+              << "std::stod:            " << ns(T3 - T2) << " ns/field (checksum " << sum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "ecef-conversion.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Test ECEFConversion at known positions.") {
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+    ECEFConversion::toECEF(0.0, 0.0, 0.0, x, y, z);
+    REQUIRE(6378137.0 == Approx(x));
+    REQUIRE(1e-9 > std::fabs(y));
+    REQUIRE(1e-9 > std::fabs(z));
+
+    ECEFConversion::toECEF(90.0, 0.0, 0.0, x, y, z);
+    REQUIRE(1e-6 > std::fabs(x));
+    REQUIRE(6356752.314245 == Approx(z));
+}
+
+TEST_CASE("Test ECEFConversion batch matches the scalar reference.") {
+    // Grid over the whole globe including the poles and the antimeridian.
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> altitude;
+    for (int32_t i{0}; i <= 180; i++) {
+        for (int32_t j{0}; j <= 360; j += 3) {
+            latitude.push_back(-90.0 + i * 1.0);
+            longitude.push_back(-180.0 + j * 1.0 + 0.123456789);
+            altitude.push_back(-100.0 + (i + j) * 10.0);
+        }
+    }
+    latitude.push_back(-90.0);
+    longitude.push_back(180.0);
+    altitude.push_back(0.0);
+    latitude.push_back(90.0);
+    longitude.push_back(-180.0);
+    altitude.push_back(8848.0);
+
+    const size_t COUNT{latitude.size()};
+    std::vector<double> x(COUNT);
+    std::vector<double> y(COUNT);
+    std::vector<double> z(COUNT);
+    ECEFConversion::toECEF(latitude.data(), longitude.data(), altitude.data(), x.data(), y.data(), z.data(), COUNT);
+
+    double maxError{0.0};
+    for (size_t i{0}; i < COUNT; i++) {
+        double refX{0.0};
+        double refY{0.0};
+        double refZ{0.0};
+        ECEFConversion::toECEF(latitude[i], longitude[i], altitude[i], refX, refY, refZ);
+        maxError = std::fmax(maxError, std::fabs(x[i] - refX));
+        maxError = std::fmax(maxError, std::fabs(y[i] - refY));
+        maxError = std::fmax(maxError, std::fabs(z[i] - refZ));
+    }
+    REQUIRE(1e-4 > maxError);
+}
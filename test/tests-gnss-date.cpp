@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "gnss-date.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace {
+int64_t toMilliseconds(const std::chrono::system_clock::time_point &tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+}
+
+TEST_CASE("Test GNSSDate parsing time of day.") {
+    int64_t ms{0};
+    REQUIRE(GNSSDate::parseTimeOfDay("123519", 6, ms));
+    REQUIRE(45319000 == ms);
+    REQUIRE(GNSSDate::parseTimeOfDay("235959.875", 10, ms));
+    REQUIRE(86399875 == ms);
+    REQUIRE(GNSSDate::parseTimeOfDay("000000.5", 8, ms));
+    REQUIRE(500 == ms);
+
+    REQUIRE(!GNSSDate::parseTimeOfDay("12351", 5, ms));
+    REQUIRE(!GNSSDate::parseTimeOfDay("12a519", 6, ms));
+    REQUIRE(!GNSSDate::parseTimeOfDay("1235190", 7, ms));
+    REQUIRE(!GNSSDate::parseTimeOfDay(nullptr, 0, ms));
+}
+
+TEST_CASE("Test GNSSDate days from civil date.") {
+    REQUIRE(0 == GNSSDate::daysFromCivil(1970, 1, 1));
+    REQUIRE(11016 == GNSSDate::daysFromCivil(2000, 2, 29));
+    REQUIRE(17896 == GNSSDate::daysFromCivil(2018, 12, 31));
+}
+
+TEST_CASE("Test GNSSDate with date from RMC and midnight rollover.") {
+    GNSSDate d;
+    REQUIRE(!d.hasDate());
+
+    REQUIRE(!d.setDate("311318", 6));
+    REQUIRE(!d.setDate("3112", 4));
+    REQUIRE(!d.hasDate());
+
+    d.update(86399000);
+    REQUIRE(d.setDate("311218", 6));
+    REQUIRE(d.hasDate());
+    REQUIRE(1546300799000 == toMilliseconds(d.timePoint(86399000)));
+
+    // Time of day jumping back by more than twelve hours is the next day.
+    d.update(500);
+    REQUIRE(1546300800500 == toMilliseconds(d.timePoint(500)));
+
+    // Small steps back (e.g., out-of-order sentences) keep the day.
+    d.update(400);
+    REQUIRE(1546300800400 == toMilliseconds(d.timePoint(400)));
+
+    // The new date from RMC is consistent with the rollover.
+    REQUIRE(d.setDate("010119", 6));
+    REQUIRE(1546300800500 == toMilliseconds(d.timePoint(500)));
+}
+
+TEST_CASE("Test GNSSDate with date from ZDA.") {
+    GNSSDate d;
+    REQUIRE(!d.setDate(2018, 13, 1));
+    REQUIRE(!d.setDate(2018, 2, 0));
+    REQUIRE(d.setDate(2000, 2, 29));
+    REQUIRE(951782400000 == toMilliseconds(d.timePoint(0)));
+}
+
+TEST_CASE("Test GNSSDate with late sentences from before midnight.") {
+    GNSSDate d;
+    REQUIRE(d.update(86399000));
+    REQUIRE(d.setDate("311218", 6));
+
+    // GGA of the new day followed by GST of the last epoch of the old day.
+    REQUIRE(d.update(0));
+    REQUIRE(1546300800000 == toMilliseconds(d.timePoint(0)));
+    REQUIRE(!d.update(86399900));
+    REQUIRE(1546300799900 == toMilliseconds(d.timePoint(86399900)));
+    // A late RMC must not set its date.
+    REQUIRE(d.update(100));
+    REQUIRE(1546300800100 == toMilliseconds(d.timePoint(100)));
+
+    // The late sentence did not advance the day a second time.
+    REQUIRE(d.update(200));
+    REQUIRE(1546300800200 == toMilliseconds(d.timePoint(200)));
+
+    // Larger jumps forward (e.g., after an outage) are taken as they are.
+    REQUIRE(d.update(13 * 3600 * 1000));
+    REQUIRE(1546300800000 + 13 * 3600 * 1000 == toMilliseconds(d.timePoint(13 * 3600 * 1000)));
+}
+
+TEST_CASE("Test GNSSDate caches the date from ZDA.") {
+    GNSSDate d;
+    REQUIRE(d.setDate(2018, 12, 31));
+    REQUIRE(d.setDate("311218", 6));
+    REQUIRE(d.setDate(2018, 12, 31));
+    REQUIRE(1546214400000 == toMilliseconds(d.timePoint(0)));
+
+    // A different date from RMC after ZDA is taken.
+    REQUIRE(d.setDate("010119", 6));
+    REQUIRE(1546300800000 == toMilliseconds(d.timePoint(0)));
+    REQUIRE(d.setDate(2018, 12, 31));
+    REQUIRE(d.setDate("010119", 6));
+    REQUIRE(1546300800000 == toMilliseconds(d.timePoint(0)));
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "gnss-filter.hpp"
+
+#include <chrono>
+#include <cmath>
+
+namespace {
+    constexpr double METERS_PER_DEGREE_LATITUDE{111412.9};  /*at 57.7 degrees*/
+}
+
+TEST_CASE("Test GNSSFilter starts with the first position.") {
+    GNSSFilter f;
+    REQUIRE(!f.isInitialized());
+    f.setSpeed(1.0f, std::chrono::system_clock::time_point{});
+    REQUIRE(!f.isInitialized());
+
+    f.setPosition(57.7, 11.9, std::chrono::system_clock::time_point{});
+    REQUIRE(f.isInitialized());
+    const GNSSFilterState S{f.state()};
+    REQUIRE(57.7 == Approx(S.latitude));
+    REQUIRE(11.9 == Approx(S.longitude));
+    REQUIRE(2.5f == Approx(S.sigmaPosition));
+}
+
+TEST_CASE("Test GNSSFilter follows constant velocity.") {
+    GNSSFilter f;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    // 10 m/s north with positions alternating 1 m east and west.
+    for (uint32_t i{0}; i <= 100; i++) {
+        const double NORTH{10.0 * i * 0.1};
+        const double EAST{(0 == i % 2) ? 1.0 : -1.0};
+        f.setPosition(57.7 + NORTH / METERS_PER_DEGREE_LATITUDE, 11.9 + EAST / 59570.0, tp);
+        f.setHeading(0.0f, tp);
+        f.setSpeed(10.0f, tp);
+        tp += std::chrono::milliseconds(100);
+    }
+    const GNSSFilterState S{f.state()};
+    REQUIRE(10.0f == Approx(S.groundSpeed).margin(0.1));
+    REQUIRE(0.05 > std::fabs(std::remainder(static_cast<double>(S.northHeading), 2.0 * M_PI)));
+    REQUIRE(0.5 > std::fabs((S.latitude - 57.7) * METERS_PER_DEGREE_LATITUDE - 100.0));
+    REQUIRE(0.5 > std::fabs((S.longitude - 11.9) * 59570.0));
+    REQUIRE(2.5f > S.sigmaPosition);
+}
+
+TEST_CASE("Test GNSSFilter smooths course at low speed.") {
+    GNSSFilter f;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    f.setSpeed(0.05f, tp);
+    f.setHeading(0.5f, tp);
+    f.setPosition(57.7, 11.9, tp);
+    float minHeading{10.0f};
+    float maxHeading{-10.0f};
+    for (uint32_t i{0}; i < 100; i++) {
+        tp += std::chrono::milliseconds(100);
+        f.setPosition(57.7, 11.9, tp);
+        f.setHeading((0 == i % 2) ? 1.5f : -0.5f, tp);
+        f.setSpeed(0.05f, tp);
+        if (50 < i) {
+            minHeading = std::fmin(minHeading, f.state().northHeading);
+            maxHeading = std::fmax(maxHeading, f.state().northHeading);
+        }
+    }
+    REQUIRE(0.2f > maxHeading - minHeading);
+    REQUIRE(0.5f == Approx(0.5f * (minHeading + maxHeading)).margin(0.2));
+    REQUIRE(0.1f > f.state().groundSpeed);
+}
+
+TEST_CASE("Test GNSSFilter weights positions by GST.") {
+    const std::chrono::system_clock::time_point TP{std::chrono::seconds(1000)};
+    GNSSFilter loose;
+    GNSSFilter tight;
+    tight.setPositionError(0.01f, 0.01f);
+    loose.setPosition(57.7, 11.9, TP);
+    tight.setPosition(57.7, 11.9, TP);
+
+    // 1 m jump north.
+    loose.setPosition(57.7 + 1.0 / METERS_PER_DEGREE_LATITUDE, 11.9, TP + std::chrono::milliseconds(100));
+    tight.setPosition(57.7 + 1.0 / METERS_PER_DEGREE_LATITUDE, 11.9, TP + std::chrono::milliseconds(100));
+    const double LOOSE{(loose.state().latitude - 57.7) * METERS_PER_DEGREE_LATITUDE};
+    const double TIGHT{(tight.state().latitude - 57.7) * METERS_PER_DEGREE_LATITUDE};
+    REQUIRE(0.99 < TIGHT);
+    REQUIRE(0.9 > LOOSE);
+    REQUIRE(0.01f > tight.state().sigmaPosition);
+}
+
+TEST_CASE("Test GNSSFilter starts over after a gap.") {
+    const std::chrono::system_clock::time_point TP{std::chrono::seconds(1000)};
+    GNSSFilter f;
+    f.setPosition(57.7, 11.9, TP);
+    f.setPosition(57.8, 12.0, TP + std::chrono::seconds(6));
+    REQUIRE(57.8 == Approx(f.state().latitude));
+    REQUIRE(12.0 == Approx(f.state().longitude));
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "heading-estimator.hpp"
+
+#include <chrono>
+#include <cmath>
+
+namespace {
+    constexpr double METERS_PER_DEGREE_LATITUDE{111412.9};   /*at 57.7 degrees*/
+    constexpr double METERS_PER_DEGREE_LONGITUDE{59644.5};   /*at 57.7 degrees*/
+}
+
+TEST_CASE("Test HeadingEstimator with straight line to the south-west.") {
+    HeadingEstimator h;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    float heading{0.0f};
+    for (uint32_t i{0}; i < 2; i++) {
+        REQUIRE(!h.update(57.7 - 1.0 * i / METERS_PER_DEGREE_LATITUDE, 11.9 - 1.0 * i / METERS_PER_DEGREE_LONGITUDE, tp, heading));
+        tp += std::chrono::milliseconds(100);
+    }
+    // Noise of +/-0.1 m across the track.
+    for (uint32_t i{2}; i < 100; i++) {
+        const double NOISE{(0 == i % 2) ? 0.1 : -0.1};
+        REQUIRE(h.update(57.7 - (1.0 * i + NOISE) / METERS_PER_DEGREE_LATITUDE, 11.9 - (1.0 * i - NOISE) / METERS_PER_DEGREE_LONGITUDE, tp, heading));
+        REQUIRE(std::fabs(heading - 1.25 * M_PI) < 0.05);
+        tp += std::chrono::milliseconds(100);
+    }
+}
+
+TEST_CASE("Test HeadingEstimator to the north across the reference bounds.") {
+    HeadingEstimator h;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    float heading{0.0f};
+    uint32_t estimated{0};
+    // 30 m/s for 90 s.
+    for (uint32_t i{0}; i < 900; i++) {
+        if (h.update(57.7 + 3.0 * i / METERS_PER_DEGREE_LATITUDE, 11.9, tp, heading)) {
+            REQUIRE(std::fabs(std::remainder(static_cast<double>(heading), 2.0 * M_PI)) < 1e-3);
+            estimated++;
+        }
+        tp += std::chrono::milliseconds(100);
+    }
+    REQUIRE(898 == estimated);
+}
+
+TEST_CASE("Test HeadingEstimator below the minimum speed, with gaps, and repeated epochs.") {
+    HeadingEstimator h{1.0};
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    float heading{0.0f};
+    // 0.5 m/s to the east.
+    for (uint32_t i{0}; i < 10; i++) {
+        REQUIRE(!h.update(57.7, 11.9 + 0.5 * i / METERS_PER_DEGREE_LONGITUDE, tp, heading));
+        tp += std::chrono::seconds(1);
+    }
+    // 5 m/s to the east.
+    double longitude{11.9};
+    for (uint32_t i{0}; i < 3; i++) {
+        longitude += 5.0 / METERS_PER_DEGREE_LONGITUDE;
+        h.update(57.7, longitude, tp, heading);
+        tp += std::chrono::seconds(1);
+    }
+    REQUIRE(std::fabs(heading - 0.5 * M_PI) < 1e-3);
+    // The same epoch from another sentence.
+    REQUIRE(!h.update(57.7, longitude, tp - std::chrono::seconds(1), heading));
+
+    // Start over after a gap.
+    tp += std::chrono::seconds(10);
+    REQUIRE(!h.update(57.7, longitude, tp, heading));
+    tp += std::chrono::seconds(1);
+    REQUIRE(!h.update(57.7, longitude - 5.0 / METERS_PER_DEGREE_LONGITUDE, tp, heading));
+    tp += std::chrono::seconds(1);
+    REQUIRE(h.update(57.7, longitude - 10.0 / METERS_PER_DEGREE_LONGITUDE, tp, heading));
+    REQUIRE(std::fabs(heading - 1.5 * M_PI) < 1e-3);
+}
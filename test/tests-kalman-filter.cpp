@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "kalman-filter.hpp"
+
+#include <array>
+
+TEST_CASE("Test KalmanFilter averages repeated measurements.") {
+    KalmanFilter<1> k;
+    k.reset({{0.0}}, {{1e6}});
+    for (uint32_t i{0}; i < 100; i++) {
+        k.update(0, ((0 == i % 2) ? 9.0 : 11.0) - k.state()[0], 4.0);
+    }
+    REQUIRE(10.0 == Approx(k.state()[0]).margin(0.05));
+    REQUIRE(0.04 == Approx(k.variance(0)).epsilon(1e-3));
+}
+
+TEST_CASE("Test KalmanFilter with constant velocity.") {
+    KalmanFilter<2> k;
+    k.reset({{0.0, 0.0}}, {{1.0, 100.0}});
+    const KalmanFilter<2>::Matrix F{{{{1.0, 0.1}}, {{0.0, 1.0}}}};
+    const KalmanFilter<2>::Matrix Q{{{{1e-6, 0.0}}, {{0.0, 1e-6}}}};
+    for (uint32_t i{1}; i <= 50; i++) {
+        k.predict(F, Q);
+        k.update(0, 0.2 * i - k.state()[0], 0.01);
+    }
+    // The velocity is observed through the correlation with the position.
+    REQUIRE(10.0 == Approx(k.state()[0]).margin(0.01));
+    REQUIRE(2.0 == Approx(k.state()[1]).margin(0.01));
+    REQUIRE(1.0 > k.variance(1));
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "local-frame.hpp"
+
+#include <chrono>
+
+TEST_CASE("Test LocalFrame maps positions close to the reference.") {
+    LocalFrame f;
+    REQUIRE(!f.hasReference());
+    f.setReference(57.7, 11.9);
+    REQUIRE(f.hasReference());
+
+    // 0.01 degrees of latitude and longitude at 57.7 degrees.
+    const std::array<double, 2> EAST{f.toLocal(57.7, 11.91)};
+    const std::array<double, 2> NORTH{f.toLocal(57.71, 11.9)};
+    REQUIRE(596.266 == Approx(EAST[0]).epsilon(1e-5));
+    REQUIRE(0.0 == Approx(EAST[1]));
+    REQUIRE(0.0 == Approx(NORTH[0]));
+    REQUIRE(1113.723 == Approx(NORTH[1]).epsilon(1e-5));
+
+    const std::array<double, 2> POSITION{f.toWGS84(EAST[0], NORTH[1])};
+    REQUIRE(57.71 == Approx(POSITION[0]).epsilon(1e-12));
+    REQUIRE(11.91 == Approx(POSITION[1]).epsilon(1e-12));
+
+    // Across the antimeridian.
+    f.setReference(-16.0, 179.9999);
+    const std::array<double, 2> WEST{f.toLocal(-16.0, -179.9999)};
+    REQUIRE(21.4 == Approx(WEST[0]).epsilon(1e-2));
+    REQUIRE(-179.9999 == Approx(f.toWGS84(WEST[0], 0.0)[1]).epsilon(1e-12));
+
+    f.reset();
+    REQUIRE(!f.hasReference());
+}
+
+TEST_CASE("Test LocalFrame tells repeated epochs apart.") {
+    LocalFrame f;
+    const std::chrono::system_clock::time_point TP{std::chrono::seconds(1000)};
+    double gap{-1.0};
+    REQUIRE(f.nextEpoch(TP, gap));
+    REQUIRE(0.0 == Approx(gap));
+    // RMC after GGA of the same epoch.
+    REQUIRE(!f.nextEpoch(TP, gap));
+    REQUIRE(f.nextEpoch(TP + std::chrono::milliseconds(200), gap));
+    REQUIRE(0.2 == Approx(gap));
+    // The epoch is kept when the reference is dropped.
+    f.reset();
+    REQUIRE(!f.nextEpoch(TP + std::chrono::milliseconds(200), gap));
+    REQUIRE(f.nextEpoch(TP, gap));
+    REQUIRE(-0.2 == Approx(gap));
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "local-tangent-plane.hpp"
+#include "wgs84.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace {
+    // Textbook conversion with the library functions for each position.
+    std::array<double, 3> referenceENU(const std::array<double, 3> &origin, const double &latitude, const double &longitude, const double &altitude) {
+        constexpr double DEG2RAD{M_PI / 180.0};
+        auto toECEF = [](const double &lat, const double &lon, const double &alt) {
+            const double N{WGS84::A / std::sqrt(1.0 - WGS84::E2 * std::sin(lat) * std::sin(lat))};
+            return std::array<double, 3>{{(N + alt) * std::cos(lat) * std::cos(lon),
+                                          (N + alt) * std::cos(lat) * std::sin(lon),
+                                          (N * (1.0 - WGS84::E2) + alt) * std::sin(lat)}};
+        };
+        const double LAT0{origin[0] * DEG2RAD};
+        const double LON0{origin[1] * DEG2RAD};
+        const std::array<double, 3> P0{toECEF(LAT0, LON0, origin[2])};
+        const std::array<double, 3> P{toECEF(latitude * DEG2RAD, longitude * DEG2RAD, altitude)};
+        const double DX{P[0] - P0[0]};
+        const double DY{P[1] - P0[1]};
+        const double DZ{P[2] - P0[2]};
+        return std::array<double, 3>{{-std::sin(LON0) * DX + std::cos(LON0) * DY,
+                                      -std::sin(LAT0) * std::cos(LON0) * DX - std::sin(LAT0) * std::sin(LON0) * DY + std::cos(LAT0) * DZ,
+                                      std::cos(LAT0) * std::cos(LON0) * DX + std::cos(LAT0) * std::sin(LON0) * DY + std::sin(LAT0) * DZ}};
+    }
+}
+
+TEST_CASE("Test LocalTangentPlane without origin.") {
+    LocalTangentPlane ltp;
+    REQUIRE(!ltp.hasOrigin());
+
+    ltp.setOrigin(57.71, 11.94, 42.0);
+    REQUIRE(ltp.hasOrigin());
+    REQUIRE(57.71 == Approx(ltp.origin()[0]));
+    REQUIRE(11.94 == Approx(ltp.origin()[1]));
+    REQUIRE(42.0 == Approx(ltp.origin()[2]));
+
+    const std::array<double, 3> ENU{ltp.toENU(57.71, 11.94, 42.0)};
+    REQUIRE(1e-9 > std::fabs(ENU[0]));
+    REQUIRE(1e-9 > std::fabs(ENU[1]));
+    REQUIRE(1e-9 > std::fabs(ENU[2]));
+}
+
+TEST_CASE("Test LocalTangentPlane along the axes.") {
+    LocalTangentPlane ltp;
+    ltp.setOrigin(0.0, 0.0, 0.0);
+
+    // One arc minute along the equator and along the meridian.
+    std::array<double, 3> enu{ltp.toENU(0.0, 1.0 / 60.0, 0.0)};
+    REQUIRE(1855.32 == Approx(enu[0]).margin(0.01));
+    REQUIRE(1e-9 > std::fabs(enu[1]));
+    enu = ltp.toENU(1.0 / 60.0, 0.0, 0.0);
+    REQUIRE(1e-9 > std::fabs(enu[0]));
+    REQUIRE(1842.90 == Approx(enu[1]).margin(0.01));
+    enu = ltp.toENU(0.0, 0.0, 10.0);
+    REQUIRE(10.0 == Approx(enu[2]));
+}
+
+TEST_CASE("Test LocalTangentPlane matches the textbook conversion.") {
+    const std::array<double, 3> ORIGIN{{57.71, 11.94, 42.0}};
+    LocalTangentPlane ltp;
+    ltp.setOrigin(ORIGIN[0], ORIGIN[1], ORIGIN[2]);
+
+    // From meters up to beyond the range of the series.
+    for (const double d : {1e-5, 1e-3, 0.1, 0.9, 1.5, -3.0}) {
+        const std::array<double, 3> ENU{ltp.toENU(ORIGIN[0] + d, ORIGIN[1] - d, ORIGIN[2] + d)};
+        const std::array<double, 3> EXPECTED{referenceENU(ORIGIN, ORIGIN[0] + d, ORIGIN[1] - d, ORIGIN[2] + d)};
+        for (uint32_t i{0}; i < 3; i++) {
+            REQUIRE(1e-6 > std::fabs(ENU[i] - EXPECTED[i]));
+        }
+    }
+}
+
+TEST_CASE("Test LocalTangentPlane across the antimeridian.") {
+    const std::array<double, 3> ORIGIN{{-16.5, 179.999, 0.0}};
+    LocalTangentPlane ltp;
+    ltp.setOrigin(ORIGIN[0], ORIGIN[1], ORIGIN[2]);
+
+    const std::array<double, 3> ENU{ltp.toENU(-16.5, -179.999, 0.0)};
+    const std::array<double, 3> EXPECTED{referenceENU(ORIGIN, -16.5, -179.999, 0.0)};
+    REQUIRE(0.0 < ENU[0]);
+    REQUIRE(250.0 > ENU[0]);
+    for (uint32_t i{0}; i < 3; i++) {
+        REQUIRE(1e-6 > std::fabs(ENU[i] - EXPECTED[i]));
+    }
+}
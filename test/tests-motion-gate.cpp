@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "motion-gate.hpp"
+
+#include <chrono>
+
+namespace {
+    constexpr double METERS_PER_DEGREE_LATITUDE{111412.9};  /*at 57.7 degrees*/
+}
+
+TEST_CASE("Test MotionGate accepts consistent positions.") {
+    MotionGate g;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    g.setSpeed(20.0f);
+    for (uint32_t i{0}; i < 50; i++) {
+        REQUIRE(g.accept(57.7 + 2.0 * i / METERS_PER_DEGREE_LATITUDE, 11.9, tp));
+        tp += std::chrono::milliseconds(100);
+    }
+    REQUIRE(50 == g.acceptedPositions());
+    REQUIRE(0 == g.rejectedPositions());
+}
+
+TEST_CASE("Test MotionGate rejects a multipath jump.") {
+    MotionGate g;
+    const std::chrono::system_clock::time_point TP{std::chrono::seconds(1000)};
+    g.setSpeed(1.0f);
+    REQUIRE(g.accept(57.7, 11.9, TP));
+
+    // 50 m within 100 ms at 1 m/s.
+    REQUIRE(!g.accept(57.7 + 50.0 / METERS_PER_DEGREE_LATITUDE, 11.9, TP + std::chrono::milliseconds(100)));
+    // Back on track, and within the margin of the last accepted position.
+    REQUIRE(g.accept(57.7 + 0.2 / METERS_PER_DEGREE_LATITUDE, 11.9, TP + std::chrono::milliseconds(200)));
+    // Across the antimeridian in longitude is a jump as well.
+    REQUIRE(!g.accept(57.7, -168.1, TP + std::chrono::milliseconds(300)));
+    REQUIRE(2 == g.acceptedPositions());
+    REQUIRE(2 == g.rejectedPositions());
+
+    // At higher speed, the same distance after a longer time is fine.
+    g.setSpeed(15.0f);
+    REQUIRE(g.accept(57.7 + 50.0 / METERS_PER_DEGREE_LATITUDE, 11.9, TP + std::chrono::seconds(3)));
+}
+
+TEST_CASE("Test MotionGate recovers from an outlier as first position.") {
+    MotionGate g{10.0, 5.0, 3};
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    REQUIRE(g.accept(57.7 + 100.0 / METERS_PER_DEGREE_LATITUDE, 11.9, tp));
+    for (uint32_t i{0}; i < 3; i++) {
+        tp += std::chrono::milliseconds(100);
+        REQUIRE(!g.accept(57.7, 11.9, tp));
+    }
+    tp += std::chrono::milliseconds(100);
+    REQUIRE(g.accept(57.7, 11.9, tp));
+    tp += std::chrono::milliseconds(100);
+    REQUIRE(g.accept(57.7, 11.9, tp));
+    REQUIRE(3 == g.rejectedPositions());
+}
@@ -19,8 +19,10 @@
 #include "catch.hpp"
 
 #include "nmea-decoder.hpp"
+#include "rtcm3-frame.hpp"
 
 #include <chrono>
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -116,7 +118,7 @@ TEST_CASE("Test NMEADecoder with single sample RMC.") {
 
 TEST_CASE("Test NMEADecoder with two consecutive sample GGAs.") {
     const std::string GGA1{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
-    const std::string GGA2{"$GPGGA,172814.0,3723.46587704,S,12202.26957864,E,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    const std::string GGA2{"$GPGGA,172814.0,3723.46587704,S,12202.26957864,E,2,6,1.2,18.893,M,-25.669,M,2.0,0031*40\r\n"};
 
     bool latLonCalled1{false};
     bool latLonCalled2{false};
@@ -166,7 +168,7 @@ TEST_CASE("Test NMEADecoder with two consecutive sample GGAs.") {
 
 TEST_CASE("Test NMEADecoder with two consecutive sample GGA and RMC.") {
     const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
-    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.6,054.7,191194,020.3,E*68\r\n"};
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.6,054.7,191194,020.3,E*6B\r\n"};
 
     bool latLonCalled1{false};
     bool latLonCalled2{false};
@@ -281,7 +283,7 @@ TEST_CASE("Test NMEADecoder with fragmented sample GGA with leading and trailing
 TEST_CASE("Test NMEADecoder with two fragmented sample GGAs with leading junk.") {
     const std::string GGA1{"*4F\r\n$GPGGA,172814.0,3723."};
     const std::string GGA2{"46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25"};
-    const std::string GGA3{".669,M,2.0,0031*4F\r\n$GPGGA,172814.0,3823.46587704,S,12302.26957864,E,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    const std::string GGA3{".669,M,2.0,0031*4F\r\n$GPGGA,172814.0,3823.46587704,S,12302.26957864,E,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4E\r\n"};
 
     bool latLonCalled1{false};
     bool latLonCalled2{false};
@@ -333,7 +335,7 @@ TEST_CASE("Test NMEADecoder with two fragmented sample GGA and RMC with leading
     const std::string DATA1{"*4F\r\n$GPGGA,172814.0,3723."};
     const std::string DATA2{"46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25"};
     const std::string DATA3{".669,M,2.0,0031*4F\r\n$GPRMC,225446,A,4916.45,N,12311.12,W,2,054.7"};
-    const std::string DATA4{",191194,020.3,E*68\r\n$GPGGA,172814.0"};
+    const std::string DATA4{",191194,020.3,E*71\r\n$GPGGA,172814.0"};
 
     bool latLonCalled1{false};
     bool latLonCalled2{false};
@@ -392,3 +394,872 @@ TEST_CASE("Test NMEADecoder with two fragmented sample GGA and RMC with leading
     REQUIRE(1.02888f == Approx(speed));
 }
 
+
+TEST_CASE("Test NMEADecoder uses time of arrival by default.") {
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"};
+
+    std::chrono::system_clock::time_point sampleTime;
+    NMEADecoder d{
+        [&sampleTime](const double &, const double &, const std::chrono::system_clock::time_point &tp){ sampleTime = tp; },
+        nullptr,
+        nullptr
+    };
+    const std::chrono::system_clock::time_point ARRIVAL{std::chrono::seconds(1000)};
+    d.decode(RMC, std::chrono::system_clock::time_point(ARRIVAL));
+
+    REQUIRE(ARRIVAL == sampleTime);
+}
+
+TEST_CASE("Test NMEADecoder with GNSS time from RMC and GGA crossing midnight.") {
+    const std::string GGA1{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"};
+    const std::string GGA2{"$GPGGA,000000.50,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*73\r\n"};
+
+    std::chrono::system_clock::time_point positionTime;
+    std::chrono::system_clock::time_point headingTime;
+    NMEADecoder d{
+        [&positionTime](const double &, const double &, const std::chrono::system_clock::time_point &tp){ positionTime = tp; },
+        [&headingTime](const float &, const std::chrono::system_clock::time_point &tp){ headingTime = tp; },
+        nullptr
+    };
+    d.useGNSSTime(true);
+    const std::chrono::system_clock::time_point ARRIVAL{std::chrono::seconds(1000)};
+
+    // No date known yet.
+    d.decode(GGA1, std::chrono::system_clock::time_point(ARRIVAL));
+    REQUIRE(ARRIVAL == positionTime);
+
+    d.decode(RMC, std::chrono::system_clock::time_point(ARRIVAL));
+    REQUIRE(std::chrono::system_clock::time_point(std::chrono::seconds(785285686)) == positionTime);
+    REQUIRE(positionTime == headingTime);
+
+    d.decode(GGA2, std::chrono::system_clock::time_point(ARRIVAL));
+    REQUIRE(std::chrono::system_clock::time_point(std::chrono::milliseconds(785289600500)) == positionTime);
+}
+
+TEST_CASE("Test NMEADecoder passes on raw sentences with valid checksum.") {
+    const std::string DATA{"junk$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"
+                           "$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"
+                           "$GPRMC,225446,A,4916.45,N,12311.12,W,000.6,054.7,191194,020.3,E*68\r\n"
+                           "$GPHDT,123.456,T*3"};
+    const std::string DATA2{"2\r\n"};
+
+    std::vector<std::string> sentences;
+    bool latLonCalled{false};
+    NMEADecoder d{
+        [&latLonCalled](const double &, const double &, const std::chrono::system_clock::time_point &){ latLonCalled = true; },
+        nullptr,
+        nullptr
+    };
+    d.setDelegateRawSentence([&sentences](const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &){
+        sentences.push_back(std::string(sentence, length));
+    });
+    d.decode(DATA, std::chrono::system_clock::time_point());
+    REQUIRE(latLonCalled);
+    // RMC has an invalid checksum.
+    REQUIRE(2 == sentences.size());
+    REQUIRE("$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n" == sentences[0]);
+    REQUIRE("$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n" == sentences[1]);
+
+    d.decode(DATA2, std::chrono::system_clock::time_point());
+    REQUIRE(3 == sentences.size());
+    REQUIRE("$GPHDT,123.456,T*32\r\n" == sentences[2]);
+}
+
+TEST_CASE("Test NMEADecoder skips sentences with invalid checksum.") {
+    // Latitude corrupted from 3723.46587704 with the checksum left intact.
+    const std::string GGA{"$GPGGA,172814.0,3623.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.6,054.7,191194,020.3,E*68\r\n"};
+    // Without checksum.
+    const std::string HDT{"$GPHDT,123.456,T\r\n"};
+
+    uint32_t delegateCalls{0};
+    NMEADecoder d{
+        [&delegateCalls](const double &, const double &, const std::chrono::system_clock::time_point &){ delegateCalls++; },
+        [&delegateCalls](const float &, const std::chrono::system_clock::time_point &){ delegateCalls++; },
+        [&delegateCalls](const float &, const std::chrono::system_clock::time_point &){ delegateCalls++; }
+    };
+    d.setDelegateAltitude([&delegateCalls](const float &, const std::chrono::system_clock::time_point &){ delegateCalls++; });
+    d.setDelegateFixQuality([&delegateCalls](const NMEAFixQuality &, const std::chrono::system_clock::time_point &){ delegateCalls++; });
+    d.setDelegateEpoch([&delegateCalls](const NMEAEpoch &, const std::chrono::system_clock::time_point &){ delegateCalls++; });
+
+    d.decode(GGA + RMC, std::chrono::system_clock::time_point());
+    REQUIRE(0 == delegateCalls);
+    REQUIRE(2 == d.invalidChecksums());
+    REQUIRE(GGA.size() + RMC.size() == d.discardedBytes());
+
+    d.decode(HDT, std::chrono::system_clock::time_point());
+    REQUIRE(1 == delegateCalls);
+    REQUIRE(2 == d.invalidChecksums());
+}
+
+TEST_CASE("Test NMEADecoder with altitude and fix quality from GGA.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+
+    bool latLonCalled{false};
+    bool altitudeCalled{false};
+    bool qualityCalled{false};
+    float altitude{0.0f};
+    NMEAFixQuality quality;
+
+    NMEADecoder d{
+        [&latLonCalled](const double &, const double &, const std::chrono::system_clock::time_point &){ latLonCalled = true; },
+        nullptr,
+        nullptr
+    };
+    d.setDelegateAltitude([&altitudeCalled, &altitude](const float &a, const std::chrono::system_clock::time_point &){ altitudeCalled = true; altitude = a; });
+    d.setDelegateFixQuality([&qualityCalled, &quality](const NMEAFixQuality &q, const std::chrono::system_clock::time_point &){ qualityCalled = true; quality = q; });
+    d.decode(GGA, std::chrono::system_clock::time_point());
+
+    REQUIRE(latLonCalled);
+    REQUIRE(altitudeCalled);
+    REQUIRE(qualityCalled);
+    REQUIRE(18.893f == Approx(altitude));
+    REQUIRE(2 == quality.fixQuality);
+    REQUIRE(6 == quality.numberOfSatellites);
+    REQUIRE(1.2f == Approx(quality.hdop));
+    REQUIRE(-25.669f == Approx(quality.geoidSeparation));
+}
+
+TEST_CASE("Test NMEADecoder with GGA without fix.") {
+    const std::string GGA{"$GPGGA,002153.000,,,,,0,0,,,M,,M,,*4D\r\n"};
+
+    bool latLonCalled{false};
+    bool altitudeCalled{false};
+    bool qualityCalled{false};
+    NMEAFixQuality quality;
+
+    NMEADecoder d{
+        [&latLonCalled](const double &, const double &, const std::chrono::system_clock::time_point &){ latLonCalled = true; },
+        nullptr,
+        nullptr
+    };
+    d.setDelegateAltitude([&altitudeCalled](const float &, const std::chrono::system_clock::time_point &){ altitudeCalled = true; });
+    d.setDelegateFixQuality([&qualityCalled, &quality](const NMEAFixQuality &q, const std::chrono::system_clock::time_point &){ qualityCalled = true; quality = q; });
+    d.decode(GGA, std::chrono::system_clock::time_point());
+
+    REQUIRE(!latLonCalled);
+    REQUIRE(!altitudeCalled);
+    REQUIRE(qualityCalled);
+    REQUIRE(0 == quality.fixQuality);
+    REQUIRE(0 == quality.numberOfSatellites);
+}
+
+TEST_CASE("Test NMEADecoder with GSV groups.") {
+    const std::string GSV1{"$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"};
+    const std::string GSV2{"$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74\r\n"
+                           "$GLGSV,1,1,02,65,30,045,35,66,10,120,,1*7F\r\n"};
+    const std::string GSV3{"$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D\r\n"};
+
+    uint32_t calls{0};
+    uint64_t gpsInView{0};
+    uint64_t glonassInView{0};
+    uint32_t snr16{0};
+    uint32_t snr66{0};
+    NMEADecoder d{nullptr, nullptr, nullptr};
+    d.setDelegateSatellites([&](const SatelliteTable &table, const SatelliteTable::Constellation &c, const std::chrono::system_clock::time_point &){
+        calls++;
+        if (SatelliteTable::GPS == c) {
+            gpsInView = table.inView(c);
+            snr16 = table.snr(c, 16);
+            REQUIRE(57 == table.elevation(c, 16));
+            REQUIRE(208 == table.azimuth(c, 16));
+        }
+        if (SatelliteTable::GLONASS == c) {
+            glonassInView = table.inView(c);
+            snr66 = table.snr(c, 2);
+            REQUIRE(66 == table.prn(c, 2));
+        }
+    });
+
+    d.decode(GSV1, std::chrono::system_clock::time_point());
+    REQUIRE(0 == calls);
+    d.decode(GSV2, std::chrono::system_clock::time_point());
+    REQUIRE(1 == calls);
+    REQUIRE(2 == __builtin_popcountll(glonassInView));
+    REQUIRE(SatelliteTable::NO_SNR == snr66);
+    d.decode(GSV3, std::chrono::system_clock::time_point());
+    REQUIRE(2 == calls);
+    REQUIRE(11 == __builtin_popcountll(gpsInView));
+    REQUIRE(39 == snr16);
+
+    // Incomplete groups are not reported.
+    d.decode(GSV1 + GSV3, std::chrono::system_clock::time_point());
+    REQUIRE(2 == calls);
+}
+
+TEST_CASE("Test NMEADecoder with SBAS and several signals in GSV.") {
+    const std::string GSA{"$GPGSA,A,3,03,46,,,,,,,,,,,2.5,1.3,2.1,1*28\r\n"};
+    const std::string GSV_L1{"$GPGSV,1,1,02,03,40,083,46,46,30,180,38,1*6B\r\n"};
+    const std::string GSV_L5{"$GPGSV,1,1,01,03,40,083,30,8*53\r\n"};
+
+    std::vector<SatelliteTable::Constellation> completed;
+    uint64_t gpsUsedInView{0};
+    uint64_t sbasUsedInView{0};
+    uint32_t snr3{0};
+    NMEADecoder d{nullptr, nullptr, nullptr};
+    d.setDelegateSatellites([&](const SatelliteTable &table, const SatelliteTable::Constellation &c, const std::chrono::system_clock::time_point &){
+        completed.push_back(c);
+        gpsUsedInView = table.usedInView(SatelliteTable::GPS);
+        sbasUsedInView = table.usedInView(SatelliteTable::SBAS);
+        snr3 = table.snr(SatelliteTable::GPS, 3);
+    });
+
+    d.decode(GSA + GSV_L1, std::chrono::system_clock::time_point());
+    REQUIRE(2 == completed.size());
+    REQUIRE(SatelliteTable::GPS == completed[0]);
+    REQUIRE(SatelliteTable::SBAS == completed[1]);
+    REQUIRE((1ull << 3) == gpsUsedInView);
+    REQUIRE((1ull << 13) == sbasUsedInView);
+    REQUIRE(46 == snr3);
+
+    // The second signal must not replace the SNR of the first one.
+    d.decode(GSV_L5 + GSV_L1, std::chrono::system_clock::time_point());
+    REQUIRE(4 == completed.size());
+    REQUIRE(46 == snr3);
+}
+
+TEST_CASE("Test NMEADecoder with GST for the epoch of GGA.") {
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"};
+    const std::string DATA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"
+                           "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031*6A\r\n"};
+
+    std::chrono::system_clock::time_point positionTime;
+    std::chrono::system_clock::time_point errorTime;
+    bool errorCalled{false};
+    NMEAPositionError error;
+    NMEADecoder d{
+        [&positionTime](const double &, const double &, const std::chrono::system_clock::time_point &tp){ positionTime = tp; },
+        nullptr,
+        nullptr
+    };
+    d.useGNSSTime(true);
+    d.setDelegatePositionError([&errorCalled, &error, &errorTime](const NMEAPositionError &e, const std::chrono::system_clock::time_point &tp){ errorCalled = true; error = e; errorTime = tp; });
+    d.decode(RMC, std::chrono::system_clock::time_point());
+    d.decode(DATA, std::chrono::system_clock::time_point());
+
+    REQUIRE(errorCalled);
+    REQUIRE(positionTime == errorTime);
+    REQUIRE(0.006f == Approx(error.rms));
+    REQUIRE(0.023f == Approx(error.semiMajor));
+    REQUIRE(0.020f == Approx(error.semiMinor));
+    REQUIRE(static_cast<float>(273.6 / 180.0 * M_PI) == Approx(error.orientation));
+    REQUIRE(0.023f == Approx(error.sigmaLatitude));
+    REQUIRE(0.020f == Approx(error.sigmaLongitude));
+    REQUIRE(0.031f == Approx(error.sigmaAltitude));
+}
+
+TEST_CASE("Test NMEADecoder combines GGA and GST of one epoch.") {
+    const std::string EPOCH1{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"
+                             "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031*6A\r\n"};
+    const std::string EPOCH2{"$GPGGA,172815.0,3723.46587800,N,12202.26957900,W,2,6,1.2,18.900,M,-25.669,M,2.0,0031*4D\r\n"};
+    const std::string GSA{"$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n"};
+
+    std::vector<NMEAEpoch> epochs;
+    std::vector<std::chrono::system_clock::time_point> times;
+    NMEADecoder d{nullptr, nullptr, nullptr};
+    d.setDelegateEpoch([&epochs, &times](const NMEAEpoch &epoch, const std::chrono::system_clock::time_point &tp) {
+        epochs.push_back(epoch);
+        times.push_back(tp);
+    });
+
+    const std::chrono::system_clock::time_point ARRIVAL1{std::chrono::seconds(1)};
+    const std::chrono::system_clock::time_point ARRIVAL2{std::chrono::seconds(2)};
+    d.decode(EPOCH1, std::chrono::system_clock::time_point(ARRIVAL1));
+    REQUIRE(epochs.empty());
+    // Completed by the first sentence of the next epoch.
+    d.decode(EPOCH2, std::chrono::system_clock::time_point(ARRIVAL2));
+    REQUIRE(1 == epochs.size());
+    REQUIRE(ARRIVAL1 == times[0]);
+    REQUIRE(37.391097950666667 == Approx(epochs[0].latitude));
+    REQUIRE(-122.037826310666667 == Approx(epochs[0].longitude));
+    REQUIRE(epochs[0].hasAltitude);
+    REQUIRE(18.893f == Approx(epochs[0].altitude));
+    REQUIRE(epochs[0].hasGeoidSeparation);
+    REQUIRE(-25.669f == Approx(epochs[0].geoidSeparation));
+    REQUIRE(epochs[0].hasPositionError);
+    REQUIRE(0.023f == Approx(epochs[0].positionError.sigmaLatitude));
+    REQUIRE(0.020f == Approx(epochs[0].positionError.sigmaLongitude));
+    REQUIRE(0.031f == Approx(epochs[0].positionError.sigmaAltitude));
+    REQUIRE(!epochs[0].hasDilution);
+
+    // Repeated sentences of the same epoch do not complete it.
+    d.decode(EPOCH2 + GSA, std::chrono::system_clock::time_point(ARRIVAL2));
+    REQUIRE(1 == epochs.size());
+    d.decode(EPOCH1, std::chrono::system_clock::time_point(ARRIVAL1));
+    REQUIRE(2 == epochs.size());
+    REQUIRE(!epochs[1].hasPositionError);
+    REQUIRE(18.9f == Approx(epochs[1].altitude));
+    REQUIRE(epochs[1].hasDilution);
+    REQUIRE(5 == epochs[1].dilution.numberOfSatellitesUsed);
+    REQUIRE(1.3f == Approx(epochs[1].dilution.hdop));
+}
+
+TEST_CASE("Test NMEADecoder skips invalid fixes.") {
+    const std::string RMC_VOID{"$GPRMC,225446,V,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*7F\r\n"};
+    const std::string RMC_NOT_VALID{"$GPRMC,225447,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E,N*0B\r\n"};
+    const std::string VTG_NOT_VALID{"$GPVTG,034.4,T,034.4,M,005.5,N,010.2,K,N*2F\r\n"};
+    const std::string GGA_NO_FIX{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,0,6,1.2,18.893,M,-25.669,M,2.0,0031*4D\r\n"};
+
+    uint32_t positions{0};
+    uint32_t headings{0};
+    uint32_t speeds{0};
+    uint32_t altitudes{0};
+    uint32_t qualities{0};
+    NMEADecoder d{
+        [&positions](const double &, const double &, const std::chrono::system_clock::time_point &) { positions++; },
+        [&headings](const float &, const std::chrono::system_clock::time_point &) { headings++; },
+        [&speeds](const float &, const std::chrono::system_clock::time_point &) { speeds++; }
+    };
+    d.setDelegateAltitude([&altitudes](const float &, const std::chrono::system_clock::time_point &) { altitudes++; });
+    d.setDelegateFixQuality([&qualities](const NMEAFixQuality &, const std::chrono::system_clock::time_point &) { qualities++; });
+    d.decode(RMC_VOID + RMC_NOT_VALID + VTG_NOT_VALID + GGA_NO_FIX, std::chrono::system_clock::time_point());
+
+    REQUIRE(0 == positions);
+    REQUIRE(0 == headings);
+    REQUIRE(0 == speeds);
+    REQUIRE(0 == altitudes);
+    REQUIRE(1 == qualities);
+}
+
+TEST_CASE("Test NMEADecoder prefers HDT over VTG over RMC for heading.") {
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"};
+    const std::string VTG{"$GPVTG,034.4,T,034.4,M,005.5,N,010.2,K,A*20\r\n"};
+    const std::string HDT{"$GPHDT,274.07,T*03\r\n"};
+
+    std::vector<float> headings;
+    NMEADecoder d{
+        nullptr,
+        [&headings](const float &h, const std::chrono::system_clock::time_point &){ headings.push_back(h); },
+        nullptr
+    };
+    const std::chrono::system_clock::time_point T0{std::chrono::seconds(1000)};
+
+    // Without better sources, RMC is used.
+    d.decode(RMC, std::chrono::system_clock::time_point(T0));
+    REQUIRE(1 == headings.size());
+    REQUIRE(0.95469f == Approx(headings.back()));
+
+    // VTG is published right away and suppresses RMC afterwards.
+    d.decode(VTG + RMC, std::chrono::system_clock::time_point(T0 + std::chrono::milliseconds(100)));
+    REQUIRE(2 == headings.size());
+    REQUIRE(static_cast<float>(34.4 / 180.0 * M_PI) == Approx(headings.back()));
+
+    // HDT beats both once it was seen.
+    d.decode(RMC + VTG + HDT, std::chrono::system_clock::time_point(T0 + std::chrono::milliseconds(200)));
+    REQUIRE(4 == headings.size());
+    REQUIRE(static_cast<float>(274.07 / 180.0 * M_PI) == Approx(headings.back()));
+    d.decode(RMC + VTG + HDT, std::chrono::system_clock::time_point(T0 + std::chrono::milliseconds(300)));
+    REQUIRE(5 == headings.size());
+    REQUIRE(static_cast<float>(274.07 / 180.0 * M_PI) == Approx(headings.back()));
+
+    // Lower-priority sources are used again after HDT disappeared.
+    d.decode(VTG + RMC, std::chrono::system_clock::time_point(T0 + std::chrono::seconds(2)));
+    REQUIRE(6 == headings.size());
+    REQUIRE(static_cast<float>(34.4 / 180.0 * M_PI) == Approx(headings.back()));
+}
+
+TEST_CASE("Test NMEADecoder with Trimble PTNL,GGK.") {
+    const std::string GGK{"$PTNL,GGK,172814.00,071296,3723.46587704,N,12202.26957864,W,3,06,1.7,EHT-6.777,M*4B\r\n"};
+
+    bool latLonCalled{false};
+    double latitude{0.0};
+    double longitude{0.0};
+    std::chrono::system_clock::time_point positionTime;
+    NMEADecoder d{
+        [&latLonCalled, &latitude, &longitude, &positionTime](const double &lat, const double &lon, const std::chrono::system_clock::time_point &tp) {
+            latLonCalled = true;
+            latitude = lat;
+            longitude = lon;
+            positionTime = tp;
+        },
+        nullptr,
+        nullptr
+    };
+    d.useGNSSTime(true);
+    d.decode(GGK, std::chrono::system_clock::time_point());
+
+    REQUIRE(latLonCalled);
+    REQUIRE(37.39109795 == Approx(latitude));
+    REQUIRE(-122.03782631 == Approx(longitude));
+    // The date is given as mmddyy: 1996-07-12T17:28:14Z.
+    REQUIRE(837192494000 == std::chrono::duration_cast<std::chrono::milliseconds>(positionTime.time_since_epoch()).count());
+
+    // Quality 0 is no fix.
+    const std::string GGK_NO_FIX{"$PTNL,GGK,172815.00,071296,3723.46587704,N,12202.26957864,W,0,00,,EHT-6.777,M*67\r\n"};
+    latLonCalled = false;
+    d.decode(GGK_NO_FIX, std::chrono::system_clock::time_point());
+    REQUIRE(!latLonCalled);
+}
+
+TEST_CASE("Test NMEADecoder with Trimble PTNL,AVR for attitude and heading.") {
+    const std::string AVR{"$PTNL,AVR,181059.6,-30.5000,Yaw,+2.0000,Tilt,-1.5000,Roll,1.215,3,2.5,6*08\r\n"};
+    const std::string VTG{"$GPVTG,034.4,T,034.4,M,005.5,N,010.2,K,A*20\r\n"};
+
+    std::vector<float> headings;
+    NMEADecoder d{
+        nullptr,
+        [&headings](const float &h, const std::chrono::system_clock::time_point &){ headings.push_back(h); },
+        nullptr
+    };
+    bool attitudeCalled{false};
+    NMEAAttitude attitude;
+    d.setDelegateAttitude([&attitudeCalled, &attitude](const NMEAAttitude &a, const std::chrono::system_clock::time_point &) {
+        attitudeCalled = true;
+        attitude = a;
+    });
+
+    // The dual-antenna yaw has the priority of HDT and suppresses VTG.
+    const std::chrono::system_clock::time_point T0{std::chrono::seconds(1000)};
+    d.decode(AVR + VTG, std::chrono::system_clock::time_point(T0));
+
+    REQUIRE(attitudeCalled);
+    REQUIRE(static_cast<float>(-30.5 / 180.0 * M_PI) == Approx(attitude.yaw));
+    REQUIRE(static_cast<float>(2.0 / 180.0 * M_PI) == Approx(attitude.tilt));
+    REQUIRE(static_cast<float>(-1.5 / 180.0 * M_PI) == Approx(attitude.roll));
+    REQUIRE(1.215f == Approx(attitude.range));
+    REQUIRE(3 == attitude.quality);
+    REQUIRE(1 == headings.size());
+    REQUIRE(static_cast<float>(329.5 / 180.0 * M_PI) == Approx(headings.back()));
+
+    // Quality 0 is no fix; VTG is used instead once AVR is outdated.
+    const std::string AVR_NO_FIX{"$PTNL,AVR,181100.6,-30.5000,Yaw,+2.0000,Tilt,-1.5000,Roll,1.215,0,2.5,6*06\r\n"};
+    attitudeCalled = false;
+    d.decode(AVR_NO_FIX, std::chrono::system_clock::time_point(T0 + std::chrono::seconds(10)));
+    REQUIRE(attitudeCalled);
+    REQUIRE(0 == attitude.quality);
+    REQUIRE(1 == headings.size());
+    d.decode(VTG, std::chrono::system_clock::time_point(T0 + std::chrono::seconds(10)));
+    REQUIRE(2 == headings.size());
+    REQUIRE(static_cast<float>(34.4 / 180.0 * M_PI) == Approx(headings.back()));
+}
+
+namespace {
+// Build a UBX-NAV-PVT frame with checksum.
+std::string navPVT(const int32_t &lat, const int32_t &lon, const uint8_t &flags, const uint32_t &gSpeed = 2500) {
+    std::string payload(92, '\0');
+    auto store = [&payload](const size_t &offset, const uint32_t &value, const size_t &size) {
+        for (size_t i{0}; i < size; i++) {
+            payload[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    };
+    store(4, 2018, 2);                              // year
+    store(6, 5, 1);                                 // month
+    store(7, 1, 1);                                 // day
+    store(8, 12, 1);                                // hour
+    store(11, 0x07, 1);                             // valid
+    store(16, 500000000, 4);                        // nano
+    store(20, 3, 1);                                // fixType
+    store(21, flags, 1);                            // flags
+    store(23, 12, 1);                               // numSV
+    store(24, static_cast<uint32_t>(lon), 4);
+    store(28, static_cast<uint32_t>(lat), 4);
+    store(32, 50000, 4);                            // height
+    store(36, 10000, 4);                            // hMSL
+    store(40, 20, 4);                               // hAcc
+    store(44, 30, 4);                               // vAcc
+    store(60, gSpeed, 4);                           // gSpeed
+    store(64, 9000000, 4);                          // headMot
+    store(84, 18000000, 4);                         // headVeh
+
+    std::string frame{"\xB5\x62\x01\x07\x5C\x00", 6};
+    frame += payload;
+    uint8_t a{0};
+    uint8_t b{0};
+    for (size_t i{2}; i < frame.size(); i++) {
+        a = static_cast<uint8_t>(a + static_cast<uint8_t>(frame[i]));
+        b = static_cast<uint8_t>(b + a);
+    }
+    frame.push_back(static_cast<char>(a));
+    frame.push_back(static_cast<char>(b));
+    return frame;
+}
+}
+
+TEST_CASE("Test NMEADecoder with UBX-NAV-PVT interleaved with NMEA.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    // Latitude with a '$' byte (0x24) inside the binary payload.
+    const std::string PVT{navPVT(577000036, 119000000, 0x01 | (2 << 6))};
+
+    std::vector<double> latitudes;
+    std::chrono::system_clock::time_point positionTime;
+    float speed{0.0f};
+    float heading{0.0f};
+    NMEADecoder d{
+        [&latitudes, &positionTime](const double &lat, const double &, const std::chrono::system_clock::time_point &tp) {
+            latitudes.push_back(lat);
+            positionTime = tp;
+        },
+        [&heading](const float &h, const std::chrono::system_clock::time_point &){ heading = h; },
+        [&speed](const float &s, const std::chrono::system_clock::time_point &){ speed = s; }
+    };
+    d.useGNSSTime(true);
+    float altitude{0.0f};
+    d.setDelegateAltitude([&altitude](const float &a, const std::chrono::system_clock::time_point &){ altitude = a; });
+    NMEAFixQuality quality;
+    d.setDelegateFixQuality([&quality](const NMEAFixQuality &q, const std::chrono::system_clock::time_point &){ quality = q; });
+    NMEAPositionError error;
+    d.setDelegatePositionError([&error](const NMEAPositionError &e, const std::chrono::system_clock::time_point &){ error = e; });
+    std::vector<NMEAEpoch> epochs;
+    d.setDelegateEpoch([&epochs](const NMEAEpoch &epoch, const std::chrono::system_clock::time_point &){ epochs.push_back(epoch); });
+
+    // Split the frame to require reassembly across calls.
+    d.decode(GGA + PVT.substr(0, 40), std::chrono::system_clock::time_point());
+    REQUIRE(1 == latitudes.size());
+    d.decode(PVT.substr(40), std::chrono::system_clock::time_point());
+    REQUIRE(2 == latitudes.size());
+
+    REQUIRE(57.7000036 == Approx(latitudes[1]).epsilon(1e-12));
+    REQUIRE(2.5f == Approx(speed));
+    REQUIRE(static_cast<float>(M_PI / 2.0) == Approx(heading));
+    REQUIRE(10.0f == Approx(altitude));
+    REQUIRE(4 == quality.fixQuality);
+    REQUIRE(12 == quality.numberOfSatellites);
+    REQUIRE(40.0f == Approx(quality.geoidSeparation));
+    REQUIRE(0.02f == Approx(error.sigmaLatitude));
+    REQUIRE(0.03f == Approx(error.sigmaAltitude));
+
+    // GGA after NAV-PVT continues on the date of NAV-PVT.
+    d.decode(GGA, std::chrono::system_clock::time_point());
+    REQUIRE(3 == latitudes.size());
+    REQUIRE(2 == epochs.size());
+    REQUIRE(10.0f == Approx(epochs[1].altitude));
+    REQUIRE(epochs[1].hasGeoidSeparation);
+    REQUIRE(40.0f == Approx(epochs[1].geoidSeparation));
+    REQUIRE((1525176000000 - 12 * 3600 * 1000 + 62894000) == std::chrono::duration_cast<std::chrono::milliseconds>(positionTime.time_since_epoch()).count());
+}
+
+TEST_CASE("Test NMEADecoder with UBX-NAV-PVT epoch and invalid checksum.") {
+    std::string pvt{navPVT(577000000, 119000000, 0x01)};
+
+    std::chrono::system_clock::time_point positionTime;
+    size_t calls{0};
+    NMEADecoder d{
+        [&calls, &positionTime](const double &, const double &, const std::chrono::system_clock::time_point &tp) {
+            calls++;
+            positionTime = tp;
+        },
+        nullptr,
+        nullptr
+    };
+    d.useGNSSTime(true);
+    d.decode(pvt, std::chrono::system_clock::time_point());
+    REQUIRE(1 == calls);
+    REQUIRE(1525176000500 == std::chrono::duration_cast<std::chrono::milliseconds>(positionTime.time_since_epoch()).count());
+
+    pvt[30] = static_cast<char>(pvt[30] + 1);
+    d.decode(pvt, std::chrono::system_clock::time_point());
+    REQUIRE(1 == calls);
+}
+
+TEST_CASE("Test NMEADecoder with UBX-NAV-PVT heading while standing still.") {
+    std::vector<float> headings;
+    NMEADecoder d{
+        nullptr,
+        [&headings](const float &h, const std::chrono::system_clock::time_point &){ headings.push_back(h); },
+        nullptr
+    };
+    d.decode(navPVT(577000000, 119000000, 0x01, 100), std::chrono::system_clock::time_point());
+    REQUIRE(headings.empty());
+
+    // The heading of the vehicle is used whenever it is valid.
+    d.decode(navPVT(577000000, 119000000, 0x01 | 0x20, 100), std::chrono::system_clock::time_point());
+    REQUIRE(1 == headings.size());
+    REQUIRE(static_cast<float>(M_PI) == Approx(headings[0]));
+}
+
+TEST_CASE("Test NMEADecoder ranks UBX-NAV-PVT heading of the vehicle between courses and HDT.") {
+    const std::string RMC{"$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"};
+    const std::string HDT{"$GPHDT,123.456,T*32\r\n"};
+    std::vector<float> headings;
+    NMEADecoder d{
+        nullptr,
+        [&headings](const float &h, const std::chrono::system_clock::time_point &){ headings.push_back(h); },
+        nullptr
+    };
+    const std::chrono::system_clock::time_point T0{std::chrono::seconds(1000)};
+
+    // The heading of the vehicle is preferred over the course from RMC.
+    d.decode(navPVT(577000000, 119000000, 0x01 | 0x20, 100), T0 + std::chrono::milliseconds(0));
+    d.decode(RMC, T0 + std::chrono::milliseconds(100));
+    REQUIRE(1 == headings.size());
+    REQUIRE(static_cast<float>(M_PI) == Approx(headings[0]));
+
+    // HDT is preferred over the heading of the vehicle.
+    d.decode(HDT, T0 + std::chrono::milliseconds(200));
+    d.decode(navPVT(577000000, 119000000, 0x01 | 0x20, 100), T0 + std::chrono::milliseconds(300));
+    REQUIRE(2 == headings.size());
+    REQUIRE(static_cast<float>(123.456 / 180.0 * M_PI) == Approx(headings[1]));
+
+    // Without HDT, the heading of the vehicle is used again and the heading
+    // of motion ranks like VTG below it.
+    d.decode(navPVT(577000000, 119000000, 0x01 | 0x20, 100), T0 + std::chrono::milliseconds(2000));
+    d.decode(navPVT(577000000, 119000000, 0x01), T0 + std::chrono::milliseconds(2100));
+    REQUIRE(3 == headings.size());
+    REQUIRE(static_cast<float>(M_PI) == Approx(headings[2]));
+    d.decode(navPVT(577000000, 119000000, 0x01), T0 + std::chrono::milliseconds(4000));
+    REQUIRE(4 == headings.size());
+    REQUIRE(static_cast<float>(M_PI / 2.0) == Approx(headings[3]));
+}
+
+TEST_CASE("Test NMEADecoder does not wait for long UBX frames after a stray sync.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    // Sync followed by a declared length of 1023 bytes.
+    const std::string NOISE{"\xB5\x62\x0A\x04\xF7\x03", 6};
+
+    size_t calls{0};
+    NMEADecoder d{
+        [&calls](const double &, const double &, const std::chrono::system_clock::time_point &) { calls++; },
+        nullptr,
+        nullptr
+    };
+    d.decode(NOISE + GGA, std::chrono::system_clock::time_point());
+    REQUIRE(1 == calls);
+    REQUIRE(NOISE.size() == d.discardedBytes());
+
+    // A NAV-PVT frame is still reassembled across calls.
+    const std::string PVT{navPVT(577000000, 119000000, 0x01)};
+    d.decode(PVT.substr(0, 10), std::chrono::system_clock::time_point());
+    REQUIRE(1 == calls);
+    d.decode(PVT.substr(10), std::chrono::system_clock::time_point());
+    REQUIRE(2 == calls);
+}
+
+TEST_CASE("Test NMEADecoder skips and forwards RTCM3 frames.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    // RTCM3 frame whose payload looks like the begin of a GGA sentence.
+    const std::string PAYLOAD{"$GPGGA,000000.0,0000.0,N,00000.0,E,1,4,1.0,0.0,M,0.0,M,,\r\n"};
+    std::string rtcm{"\xD3\x00", 2};
+    rtcm.push_back(static_cast<char>(PAYLOAD.size()));
+    rtcm += PAYLOAD;
+    const uint32_t CRC{RTCM3Frame::crc24q(reinterpret_cast<const uint8_t*>(rtcm.data()), rtcm.size())};
+    rtcm.push_back(static_cast<char>((CRC >> 16) & 0xFF));
+    rtcm.push_back(static_cast<char>((CRC >> 8) & 0xFF));
+    rtcm.push_back(static_cast<char>(CRC & 0xFF));
+
+    std::vector<double> latitudes;
+    NMEADecoder d{
+        [&latitudes](const double &lat, const double &, const std::chrono::system_clock::time_point &) { latitudes.push_back(lat); },
+        nullptr,
+        nullptr
+    };
+    std::vector<std::string> frames;
+    d.setDelegateRTCM3Frame([&frames](const char *frame, const size_t &length, const std::chrono::system_clock::time_point &) {
+        frames.push_back(std::string(frame, length));
+    });
+
+    // Split the frame to require reassembly across calls.
+    d.decode(GGA + rtcm.substr(0, 20), std::chrono::system_clock::time_point());
+    d.decode(rtcm.substr(20) + GGA, std::chrono::system_clock::time_point());
+
+    REQUIRE(2 == latitudes.size());
+    REQUIRE(37.39109795 == Approx(latitudes[0]));
+    REQUIRE(37.39109795 == Approx(latitudes[1]));
+    REQUIRE(1 == frames.size());
+    REQUIRE(rtcm == frames[0]);
+}
+
+TEST_CASE("Test NMEADecoder does not wait for RTCM3 frames after a stray preamble.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    // Preamble followed by a declared length of 1023 bytes.
+    const std::string NOISE{"\xD3\x03\xFF", 3};
+
+    size_t calls{0};
+    NMEADecoder d{
+        [&calls](const double &, const double &, const std::chrono::system_clock::time_point &) { calls++; },
+        nullptr,
+        nullptr
+    };
+    // The sentence is only decoded once it is complete.
+    d.decode(NOISE + GGA.substr(0, 50), std::chrono::system_clock::time_point());
+    REQUIRE(0 == calls);
+    d.decode(GGA.substr(50), std::chrono::system_clock::time_point());
+    REQUIRE(1 == calls);
+    REQUIRE(NOISE.size() == d.discardedBytes());
+}
+
+TEST_CASE("Test NMEADecoder with date from ZDA across midnight.") {
+    const std::string ZDA{"$GPZDA,235959.50,31,12,2018,00,00*68\r\n"};
+    const std::string GGA_BEFORE_MIDNIGHT{"$GPGGA,235959.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*47\r\n"};
+    const std::string GGA{"$GPGGA,000000.5,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*43\r\n"};
+
+    std::chrono::system_clock::time_point positionTime;
+    NMEADecoder d{
+        [&positionTime](const double &, const double &, const std::chrono::system_clock::time_point &tp) { positionTime = tp; },
+        nullptr,
+        nullptr
+    };
+    d.useGNSSTime(true);
+    const std::chrono::system_clock::time_point ARRIVAL{std::chrono::seconds(1)};
+
+    // Without date, the time of arrival is used.
+    d.decode(GGA_BEFORE_MIDNIGHT, std::chrono::system_clock::time_point(ARRIVAL));
+    REQUIRE(ARRIVAL == positionTime);
+
+    d.decode(ZDA + GGA, std::chrono::system_clock::time_point(ARRIVAL));
+    REQUIRE(1546300800500 == std::chrono::duration_cast<std::chrono::milliseconds>(positionTime.time_since_epoch()).count());
+
+    // A late ZDA from before midnight neither sets its date nor advances the day.
+    d.decode(ZDA + GGA, std::chrono::system_clock::time_point(ARRIVAL));
+    REQUIRE(1546300800500 == std::chrono::duration_cast<std::chrono::milliseconds>(positionTime.time_since_epoch()).count());
+}
+
+TEST_CASE("Test NMEADecoder with GSA for DOP and satellites used.") {
+    const std::string GPGSA{"$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n"};
+    const std::string GNGSA_GLONASS{"$GNGSA,A,3,65,66,,,,,,,,,,,1.8,1.0,1.5,2*3D\r\n"};
+    const std::string GNGSA_GALILEO{"$GNGSA,A,3,01,02,03,,,,,,,,,,1.8,1.0,1.5,3*3F\r\n"};
+    const std::string GNGSA_LEGACY{"$GNGSA,A,3,04,70,,,,,,,,,,,1.8,1.0,1.5*23\r\n"};
+    const std::string GPGSV{"$GPGSV,1,1,03,04,40,083,46,05,17,308,41,07,10,200,*4A\r\n"};
+
+    NMEADecoder d{nullptr, nullptr, nullptr};
+    std::vector<NMEADilution> dilutions;
+    d.setDelegateDilution([&dilutions](const NMEADilution &dilution, const std::chrono::system_clock::time_point &) {
+        dilutions.push_back(dilution);
+    });
+    uint64_t usedInView{0};
+    d.setDelegateSatellites([&usedInView](const SatelliteTable &table, const SatelliteTable::Constellation &constellation, const std::chrono::system_clock::time_point &) {
+        usedInView = table.usedInView(constellation);
+    });
+
+    d.decode(GPGSA + GPGSV, std::chrono::system_clock::time_point());
+    REQUIRE(1 == dilutions.size());
+    REQUIRE(3 == dilutions[0].fixType);
+    REQUIRE(5 == dilutions[0].numberOfSatellitesUsed);
+    REQUIRE(2.5f == Approx(dilutions[0].pdop));
+    REQUIRE(1.3f == Approx(dilutions[0].hdop));
+    REQUIRE(2.1f == Approx(dilutions[0].vdop));
+    REQUIRE(((1ull << 4) | (1ull << 5)) == usedInView);
+
+    // Combined sentences with system ID add up within one epoch.
+    d.decode(GPGSA + GNGSA_GLONASS + GNGSA_GALILEO, std::chrono::system_clock::time_point());
+    REQUIRE(4 == dilutions.size());
+    REQUIRE(7 == dilutions[2].numberOfSatellitesUsed);
+    REQUIRE(10 == dilutions[3].numberOfSatellitesUsed);
+
+    // Combined sentence without system ID is split by PRN ranges; Galileo
+    // of the previous epoch is no longer counted.
+    d.decode(GPGSV + GNGSA_LEGACY, std::chrono::system_clock::time_point());
+    REQUIRE(5 == dilutions.size());
+    REQUIRE(2 == dilutions[4].numberOfSatellitesUsed);
+}
+
+TEST_CASE("Test NMEADecoder with one byte at a time.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    const std::string HDT{"$GPHDT,274.07,T*03\r\n"};
+
+    size_t positions{0};
+    double latitude{0.0};
+    size_t headings{0};
+    NMEADecoder d{
+        [&positions, &latitude](const double &lat, const double &, const std::chrono::system_clock::time_point &) {
+            positions++;
+            latitude = lat;
+        },
+        [&headings](const float &, const std::chrono::system_clock::time_point &) { headings++; },
+        nullptr
+    };
+    std::vector<std::string> sentences;
+    d.setDelegateRawSentence([&sentences](const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &) {
+        sentences.push_back(std::string(sentence, length));
+    });
+
+    const std::string DATA{GGA + HDT + GGA};
+    for (const char c : DATA) {
+        d.decode(std::string(1, c), std::chrono::system_clock::time_point());
+    }
+    REQUIRE(2 == positions);
+    REQUIRE(37.39109795 == Approx(latitude));
+    REQUIRE(1 == headings);
+    REQUIRE(3 == sentences.size());
+    REQUIRE(GGA == sentences[0]);
+    REQUIRE(HDT == sentences[1]);
+    REQUIRE(GGA == sentences[2]);
+}
+
+TEST_CASE("Test NMEADecoder resumes at '$' within a truncated sentence.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+
+    size_t positions{0};
+    NMEADecoder d{
+        [&positions](const double &, const double &, const std::chrono::system_clock::time_point &) { positions++; },
+        nullptr,
+        nullptr
+    };
+    std::vector<std::string> sentences;
+    d.setDelegateRawSentence([&sentences](const char *sentence, const size_t &length, const std::chrono::system_clock::time_point &) {
+        sentences.push_back(std::string(sentence, length));
+    });
+
+    d.decode(GGA.substr(0, 30), std::chrono::system_clock::time_point());
+    d.decode(GGA, std::chrono::system_clock::time_point());
+    REQUIRE(1 == positions);
+    REQUIRE(1 == sentences.size());
+    REQUIRE(GGA == sentences[0]);
+}
+
+TEST_CASE("Test NMEADecoder with more data than fits into its buffer.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+
+    size_t positions{0};
+    NMEADecoder d{
+        [&positions](const double &, const double &, const std::chrono::system_clock::time_point &) { positions++; },
+        nullptr,
+        nullptr
+    };
+    std::string data;
+    for (size_t i{0}; i < 50; i++) {
+        data += GGA;
+    }
+    d.decode(data, std::chrono::system_clock::time_point());
+    REQUIRE(50 == positions);
+    REQUIRE(0 == d.discardedBytes());
+}
+
+TEST_CASE("Test NMEADecoder resynchronizes after noise and counts discarded bytes.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    const std::string BANNER{"u-blox AG - www.u-blox.com\r\nHW 00080000\r\n"};
+    const std::string NOISE(5000, 'x');
+    const std::string OVERLONG{"$GPTXT," + std::string(300, 'a') + "\r\n"};
+
+    size_t positions{0};
+    NMEADecoder d{
+        [&positions](const double &, const double &, const std::chrono::system_clock::time_point &) { positions++; },
+        nullptr,
+        nullptr
+    };
+
+    d.decode(BANNER + GGA, std::chrono::system_clock::time_point());
+    REQUIRE(1 == positions);
+    REQUIRE(BANNER.size() == d.discardedBytes());
+
+    // Noise longer than the buffer within a single call.
+    d.decode(NOISE + GGA, std::chrono::system_clock::time_point());
+    REQUIRE(2 == positions);
+    REQUIRE(BANNER.size() + NOISE.size() == d.discardedBytes());
+
+    // Sentences are capped in length.
+    d.decode(OVERLONG + GGA, std::chrono::system_clock::time_point());
+    REQUIRE(3 == positions);
+    REQUIRE(1 == d.truncatedSentences());
+    REQUIRE(BANNER.size() + NOISE.size() + OVERLONG.size() == d.discardedBytes());
+}
+
+TEST_CASE("Test NMEADecoder with bit-exact RTK coordinates.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+
+    double latitude{0.0};
+    double longitude{0.0};
+    NMEADecoder d{
+        [&latitude, &longitude](const double &lat, const double &lon, const std::chrono::system_clock::time_point &) {
+            latitude = lat;
+            longitude = lon;
+        },
+        nullptr,
+        nullptr
+    };
+    d.decode(GGA, std::chrono::system_clock::time_point());
+
+    // Doubles nearest to 37+23.46587704/60 and -(122+2.26957864/60).
+    REQUIRE(37.39109795066667 == latitude);
+    REQUIRE(-122.03782631066667 == longitude);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "nmea-fields.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+TEST_CASE("Test NMEAFields tokenizes GGA without copying.") {
+    const std::string GGA{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+
+    NMEAFields f;
+    REQUIRE(15 == f.tokenize(reinterpret_cast<const uint8_t*>(GGA.data()), GGA.size()));
+    REQUIRE("$GPGGA" == std::string(f.data(0), f.length(0)));
+    REQUIRE(GGA.data() + 7 == f.data(1));
+    REQUIRE("0031" == std::string(f.data(14), f.length(14)));
+    REQUIRE('N' == f.toChar(3));
+
+    double d{0.0};
+    REQUIRE(f.toDouble(2, d));
+    REQUIRE(3723.46587704 == Approx(d));
+    REQUIRE(f.toDouble(11, d));
+    REQUIRE(-25.669 == Approx(d));
+
+    uint32_t u{0};
+    REQUIRE(f.toUInt32(7, u));
+    REQUIRE(6 == u);
+    REQUIRE(!f.toUInt32(8, u));
+
+    // Out of range.
+    REQUIRE(f.isEmpty(15));
+    REQUIRE(!f.toDouble(20, d));
+}
+
+TEST_CASE("Test NMEAFields with empty and malformed fields.") {
+    const std::string GGA{"$GPGGA,002153.000,,,,,0,0,,1.2.3,M,abc,M,,*4D\r\n"};
+
+    NMEAFields f;
+    REQUIRE(15 == f.tokenize(reinterpret_cast<const uint8_t*>(GGA.data()), GGA.size()));
+    double d{42.0};
+    REQUIRE(!f.toDouble(2, d));
+    REQUIRE(!f.toDouble(9, d));
+    REQUIRE(!f.toDouble(11, d));
+    REQUIRE(42.0 == Approx(d));
+    REQUIRE('\0' == f.toChar(3));
+    REQUIRE(f.isEmpty(14));
+}
+
+TEST_CASE("Test NMEAFields tokenizes incrementally.") {
+    const std::string HDT{"$GPHDT,274.07,T*03\r\n"};
+
+    NMEAFields f;
+    f.begin();
+    f.addSeparator(6);
+    f.addSeparator(13);
+    f.end(reinterpret_cast<const uint8_t*>(HDT.data()), 15);
+
+    REQUIRE(3 == f.size());
+    REQUIRE("$GPHDT" == std::string(f.data(0), f.length(0)));
+    REQUIRE("274.07" == std::string(f.data(1), f.length(1)));
+    REQUIRE("T" == std::string(f.data(2), f.length(2)));
+}
+
+TEST_CASE("Test NMEAFields parses coordinates into nano minutes.") {
+    const std::string DATA{"$GPGGA,3723.46587704,12202.26957864,4916.45,0000.0000000001,123,12a3.4,12,"};
+
+    NMEAFields f;
+    REQUIRE(9 == f.tokenize(reinterpret_cast<const uint8_t*>(DATA.data()), DATA.size()));
+
+    int64_t v{0};
+    REQUIRE(f.toCoordinate(1, v));
+    REQUIRE(2243465877040LL == v);
+    REQUIRE(f.toCoordinate(2, v));
+    REQUIRE(7322269578640LL == v);
+    REQUIRE(f.toCoordinate(3, v));
+    REQUIRE(2956450000000LL == v);
+    // Decimals beyond 1e-9 minutes are truncated.
+    REQUIRE(f.toCoordinate(4, v));
+    REQUIRE(0 == v);
+    REQUIRE(f.toCoordinate(5, v));
+    REQUIRE(83000000000LL == v);
+
+    REQUIRE(!f.toCoordinate(6, v));
+    REQUIRE(!f.toCoordinate(7, v));
+    REQUIRE(!f.toCoordinate(8, v));
+}
+
+TEST_CASE("Test NMEAFields coordinates agree with std::stod.") {
+    const std::string DATA{"$GPGGA,3723.46587704,12202.26957864"};
+    NMEAFields f;
+    f.tokenize(reinterpret_cast<const uint8_t*>(DATA.data()), DATA.size());
+
+    for (uint32_t i{1}; i < 3; i++) {
+        const std::string FIELD{f.data(i), f.length(i)};
+        double expected{std::stod(FIELD) / 100.0};
+        expected = static_cast<int32_t>(expected) + (expected - static_cast<int32_t>(expected)) * 100.0 / 60.0;
+
+        int64_t v{0};
+        REQUIRE(f.toCoordinate(i, v));
+        REQUIRE(1e-9 > std::fabs(static_cast<double>(v) / 60e9 - expected));
+    }
+}
+
+TEST_CASE("Test NMEAFields parses digits eight at a time.") {
+    uint64_t v{0};
+    REQUIRE(NMEAFields::parseDigits("12345678", 8, v));
+    REQUIRE(12345678ULL == v);
+
+    v = 0;
+    REQUIRE(NMEAFields::parseDigits("1234567890123456789", 19, v));
+    REQUIRE(1234567890123456789ULL == v);
+
+    // Digits are appended to the given value.
+    v = 42;
+    REQUIRE(NMEAFields::parseDigits("0000000001", 10, v));
+    REQUIRE(420000000001ULL == v);
+
+    v = 0;
+    REQUIRE(NMEAFields::parseDigits("", 0, v));
+    REQUIRE(0 == v);
+
+    // Characters next to '0' and '9' are rejected at every position of a chunk.
+    for (size_t i{0}; i < 9; i++) {
+        for (const char c : {'/', ':', ' ', '.', '\xB0'}) {
+            std::string digits{"987654321"};
+            digits[i] = c;
+            v = 7;
+            REQUIRE(!NMEAFields::parseDigits(digits.data(), digits.size(), v));
+            REQUIRE(7 == v);
+        }
+    }
+}
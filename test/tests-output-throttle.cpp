@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "output-throttle.hpp"
+
+#include <array>
+#include <chrono>
+
+TEST_CASE("Test OutputThrottle without rate limit.") {
+    OutputThrottle<1> t{0.0f, OutputThrottleMode::LATEST};
+
+    std::chrono::system_clock::time_point tp;
+    uint32_t published{0};
+    for (uint32_t i{0}; i < 20; i++) {
+        std::array<double, 1> v{{static_cast<double>(i)}};
+        published += (t.update(v, tp) ? 1 : 0);
+        REQUIRE(static_cast<double>(i) == Approx(v[0]));
+        tp += std::chrono::milliseconds(50);
+    }
+    REQUIRE(20 == published);
+}
+
+TEST_CASE("Test OutputThrottle decimating 20Hz to 5Hz with latest value.") {
+    OutputThrottle<1> t{5.0f, OutputThrottleMode::LATEST};
+
+    std::chrono::system_clock::time_point tp;
+    uint32_t published{0};
+    double lastPublished{-1.0};
+    for (uint32_t i{0}; i < 20; i++) {
+        std::array<double, 1> v{{static_cast<double>(i)}};
+        if (t.update(v, tp)) {
+            published++;
+            lastPublished = v[0];
+        }
+        tp += std::chrono::milliseconds(50);
+    }
+    REQUIRE(5 == published);
+    REQUIRE(16.0 == Approx(lastPublished));
+}
+
+TEST_CASE("Test OutputThrottle keeps average rate with jitter.") {
+    OutputThrottle<1> t{5.0f, OutputThrottleMode::LATEST};
+
+    std::chrono::system_clock::time_point tp;
+    uint32_t published{0};
+    for (uint32_t i{0}; i < 200; i++) {
+        std::array<double, 1> v{{0.0}};
+        // Alternate arrivals 5ms early and 5ms late.
+        const auto jitter = std::chrono::milliseconds((0 == (i % 2)) ? -5 : 5);
+        published += (t.update(v, tp + jitter) ? 1 : 0);
+        tp += std::chrono::milliseconds(50);
+    }
+    REQUIRE(50 == published);
+}
+
+TEST_CASE("Test OutputThrottle averaging over window.") {
+    OutputThrottle<2> t{5.0f, OutputThrottleMode::AVERAGE};
+
+    std::chrono::system_clock::time_point tp;
+    std::array<double, 2> v{{1.0, 10.0}};
+    REQUIRE(t.update(v, tp));
+    REQUIRE(1.0 == Approx(v[0]));
+    REQUIRE(10.0 == Approx(v[1]));
+
+    for (uint32_t i{1}; i < 4; i++) {
+        tp += std::chrono::milliseconds(50);
+        v = {{static_cast<double>(i), 0.0}};
+        REQUIRE(!t.update(v, tp));
+    }
+    tp += std::chrono::milliseconds(50);
+    v = {{4.0, 4.0}};
+    REQUIRE(t.update(v, tp));
+    REQUIRE(2.5 == Approx(v[0]));
+    REQUIRE(1.0 == Approx(v[1]));
+}
+
+TEST_CASE("Test OutputThrottle restarts when time goes backwards.") {
+    OutputThrottle<1> t{1.0f, OutputThrottleMode::LATEST};
+
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(100)};
+    std::array<double, 1> v{{0.0}};
+    REQUIRE(t.update(v, tp));
+    REQUIRE(!t.update(v, tp + std::chrono::milliseconds(500)));
+    REQUIRE(t.update(v, tp - std::chrono::seconds(50)));
+    REQUIRE(!t.update(v, tp - std::chrono::seconds(50) + std::chrono::milliseconds(500)));
+}
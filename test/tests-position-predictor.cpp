@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "position-predictor.hpp"
+
+#include <chrono>
+#include <cmath>
+
+TEST_CASE("Test PositionPredictor without position.") {
+    PositionPredictor p;
+    double latitude{0.0};
+    double longitude{0.0};
+    std::chrono::system_clock::time_point tp;
+    REQUIRE(!p.predict(std::chrono::system_clock::time_point{}, latitude, longitude, tp));
+}
+
+TEST_CASE("Test PositionPredictor with constant velocity.") {
+    const std::chrono::system_clock::time_point SAMPLE{std::chrono::seconds(100)};
+    const std::chrono::system_clock::time_point ARRIVAL{std::chrono::seconds(200)};
+    PositionPredictor p{std::chrono::seconds(1)};
+    p.setSpeed(10.0f);
+    p.setHeading(0.0f);
+    p.setPosition(0.0, 0.0, SAMPLE, ARRIVAL);
+
+    double latitude{0.0};
+    double longitude{0.0};
+    std::chrono::system_clock::time_point tp;
+    REQUIRE(p.predict(ARRIVAL, latitude, longitude, tp));
+    REQUIRE(0.0 == Approx(latitude));
+    REQUIRE(SAMPLE == tp);
+
+    // 5 m north at the equator.
+    REQUIRE(p.predict(ARRIVAL + std::chrono::milliseconds(500), latitude, longitude, tp));
+    REQUIRE(5.0 / 110574.28 == Approx(latitude).epsilon(1e-6));
+    REQUIRE(1e-12 > std::fabs(longitude));
+    REQUIRE(SAMPLE + std::chrono::milliseconds(500) == tp);
+
+    // 5 m east at the equator.
+    p.setHeading(static_cast<float>(M_PI / 2.0));
+    REQUIRE(p.predict(ARRIVAL + std::chrono::milliseconds(500), latitude, longitude, tp));
+    REQUIRE(1e-9 > std::fabs(latitude));
+    REQUIRE(5.0 / 111319.49 == Approx(longitude).epsilon(1e-6));
+
+    // Neither before the position arrived nor beyond the horizon.
+    REQUIRE(!p.predict(ARRIVAL - std::chrono::milliseconds(1), latitude, longitude, tp));
+    REQUIRE(!p.predict(ARRIVAL + std::chrono::milliseconds(1001), latitude, longitude, tp));
+}
+
+TEST_CASE("Test PositionPredictor corrected by a new position.") {
+    const std::chrono::system_clock::time_point ARRIVAL{std::chrono::seconds(200)};
+    PositionPredictor p;
+    p.setSpeed(20.0f);
+    p.setHeading(static_cast<float>(M_PI));
+    p.setPosition(57.7, 11.9, ARRIVAL, ARRIVAL);
+    p.setPosition(57.6, 179.99999, ARRIVAL + std::chrono::milliseconds(100), ARRIVAL + std::chrono::milliseconds(100));
+
+    double latitude{0.0};
+    double longitude{0.0};
+    std::chrono::system_clock::time_point tp;
+    REQUIRE(p.predict(ARRIVAL + std::chrono::milliseconds(100), latitude, longitude, tp));
+    REQUIRE(57.6 == Approx(latitude));
+    REQUIRE(179.99999 == Approx(longitude));
+
+    // Heading south.
+    REQUIRE(p.predict(ARRIVAL + std::chrono::milliseconds(600), latitude, longitude, tp));
+    REQUIRE(57.6 > latitude);
+    REQUIRE(57.6 - 10.0 / 111000.0 == Approx(latitude).epsilon(1e-5));
+
+    // Across the antimeridian.
+    p.setHeading(static_cast<float>(M_PI / 2.0));
+    REQUIRE(p.predict(ARRIVAL + std::chrono::milliseconds(600), latitude, longitude, tp));
+    REQUIRE(-179.9 > longitude);
+}
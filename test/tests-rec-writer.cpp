@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "cluon-complete.hpp"
+#include "rec-writer.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+TEST_CASE("Test RecWriter with invalid file.") {
+    RecWriter w{"/this/directory/does/not/exist/test.rec"};
+    REQUIRE(!w.isOpen());
+    // Must not block or crash.
+    w.write(cluon::data::Envelope());
+}
+
+TEST_CASE("Test RecWriter writes all Envelopes in order.") {
+    const std::string REC{"tests-rec-writer.rec"};
+    constexpr uint32_t ENVELOPES{1000};
+    {
+        // Small batches to exercise several writes from the background thread.
+        RecWriter w{REC, 64};
+        REQUIRE(w.isOpen());
+        for (uint32_t i{0}; i < ENVELOPES; i++) {
+            cluon::data::Envelope e;
+            e.dataType(19).senderStamp(i).sampleTimeStamp(cluon::data::TimeStamp().seconds(static_cast<int32_t>(i)));
+            w.write(std::move(e));
+        }
+    }
+
+    std::fstream recFile(REC.c_str(), std::ios::in | std::ios::binary);
+    REQUIRE(recFile.good());
+    uint32_t count{0};
+    while (recFile.good()) {
+        auto retVal = cluon::extractEnvelope(recFile);
+        if (!retVal.first) {
+            break;
+        }
+        REQUIRE(19 == retVal.second.dataType());
+        REQUIRE(count == retVal.second.senderStamp());
+        REQUIRE(static_cast<int32_t>(count) == retVal.second.sampleTimeStamp().seconds());
+        count++;
+    }
+    REQUIRE(ENVELOPES == count);
+    recFile.close();
+    std::remove(REC.c_str());
+}
+
+TEST_CASE("Test RecWriter drops Envelopes when the queue is full.") {
+    const std::string REC{"tests-rec-writer-bounded.rec"};
+    constexpr uint32_t ENVELOPES{1000};
+    uint64_t dropped{0};
+    {
+        RecWriter w{REC, 8, 16};
+        REQUIRE(w.isOpen());
+        for (uint32_t i{0}; i < ENVELOPES; i++) {
+            cluon::data::Envelope e;
+            e.dataType(19).senderStamp(i);
+            w.write(std::move(e));
+        }
+        dropped = w.droppedEnvelopes();
+    }
+
+    // Every Envelope is either recorded in order or counted as dropped.
+    std::fstream recFile(REC.c_str(), std::ios::in | std::ios::binary);
+    REQUIRE(recFile.good());
+    uint32_t count{0};
+    uint32_t lastSenderStamp{0};
+    while (recFile.good()) {
+        auto retVal = cluon::extractEnvelope(recFile);
+        if (!retVal.first) {
+            break;
+        }
+        REQUIRE(((0 == count) || (lastSenderStamp < retVal.second.senderStamp())));
+        lastSenderStamp = retVal.second.senderStamp();
+        count++;
+    }
+    REQUIRE(ENVELOPES == count + dropped);
+    recFile.close();
+    std::remove(REC.c_str());
+}
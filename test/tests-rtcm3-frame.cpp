@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "rtcm3-frame.hpp"
+
+#include <cstdint>
+
+TEST_CASE("Test RTCM3Frame CRC-24Q check value.") {
+    const uint8_t DATA[]{'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    REQUIRE(0xCDE703 == RTCM3Frame::crc24q(DATA, sizeof(DATA)));
+    REQUIRE(0 == RTCM3Frame::crc24q(DATA, 0));
+}
+
+TEST_CASE("Test RTCM3Frame with empty message.") {
+    // Frame with zero-length payload as sent to keep connections alive.
+    const uint8_t FRAME[]{0xD3, 0x00, 0x00, 0x47, 0xEA, 0x4B};
+
+    REQUIRE(RTCM3Frame::isSync(FRAME, sizeof(FRAME)));
+    REQUIRE(6 == RTCM3Frame::length(FRAME));
+    REQUIRE(RTCM3Frame::isValid(FRAME, sizeof(FRAME)));
+
+    const uint8_t RESERVED_BITS_SET[]{0xD3, 0x04, 0x00};
+    REQUIRE(!RTCM3Frame::isSync(RESERVED_BITS_SET, sizeof(RESERVED_BITS_SET)));
+
+    const uint8_t CORRUPTED[]{0xD3, 0x00, 0x00, 0x47, 0xEA, 0x4C};
+    REQUIRE(!RTCM3Frame::isValid(CORRUPTED, sizeof(CORRUPTED)));
+}
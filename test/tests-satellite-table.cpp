@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "satellite-table.hpp"
+
+TEST_CASE("Test SatelliteTable constellations from talker IDs.") {
+    REQUIRE(SatelliteTable::GPS == SatelliteTable::constellation("GP"));
+    REQUIRE(SatelliteTable::GLONASS == SatelliteTable::constellation("GL"));
+    REQUIRE(SatelliteTable::GALILEO == SatelliteTable::constellation("GA"));
+    REQUIRE(SatelliteTable::BEIDOU == SatelliteTable::constellation("GB"));
+    REQUIRE(SatelliteTable::BEIDOU == SatelliteTable::constellation("BD"));
+    REQUIRE(SatelliteTable::QZSS == SatelliteTable::constellation("GQ"));
+    REQUIRE(SatelliteTable::UNKNOWN_CONSTELLATION == SatelliteTable::constellation("GN"));
+}
+
+TEST_CASE("Test SatelliteTable replaces view with each complete group.") {
+    SatelliteTable t;
+    REQUIRE(0 == t.inView(SatelliteTable::GALILEO));
+
+    REQUIRE(t.beginSentence(SatelliteTable::GALILEO, 0, 1, 2));
+    t.add(SatelliteTable::GALILEO, 301, 45, 90, 40);
+    REQUIRE(!t.endSentence(SatelliteTable::GALILEO));
+    REQUIRE(t.beginSentence(SatelliteTable::GALILEO, 0, 2, 2));
+    t.add(SatelliteTable::GALILEO, 336, 10, 270, SatelliteTable::NO_SNR);
+    REQUIRE(t.endSentence(SatelliteTable::GALILEO));
+
+    const uint64_t FIRST{t.inView(SatelliteTable::GALILEO)};
+    REQUIRE(2 == __builtin_popcountll(FIRST));
+    REQUIRE(301 == t.prn(SatelliteTable::GALILEO, 1));
+    REQUIRE(40 == t.snr(SatelliteTable::GALILEO, 1));
+    REQUIRE(SatelliteTable::NO_SNR == t.snr(SatelliteTable::GALILEO, 36));
+
+    // Out of sequence sentences drop the group and keep the last complete view.
+    REQUIRE(t.beginSentence(SatelliteTable::GALILEO, 0, 1, 2));
+    t.add(SatelliteTable::GALILEO, 302, 45, 90, 40);
+    REQUIRE(!t.endSentence(SatelliteTable::GALILEO));
+    REQUIRE(!t.beginSentence(SatelliteTable::GALILEO, 0, 2, 3));
+    REQUIRE(FIRST == t.inView(SatelliteTable::GALILEO));
+
+    // A new group replaces the view.
+    REQUIRE(t.beginSentence(SatelliteTable::GALILEO, 0, 1, 1));
+    t.add(SatelliteTable::GALILEO, 305, 5, 5, 5);
+    REQUIRE(t.endSentence(SatelliteTable::GALILEO));
+    REQUIRE((static_cast<uint64_t>(1) << 5) == t.inView(SatelliteTable::GALILEO));
+    REQUIRE(0 == t.inView(SatelliteTable::GPS));
+}
+
+TEST_CASE("Test SatelliteTable with satellites used in the solution.") {
+    REQUIRE(SatelliteTable::GPS == SatelliteTable::constellationFromSystemID(1));
+    REQUIRE(SatelliteTable::QZSS == SatelliteTable::constellationFromSystemID(5));
+    REQUIRE(SatelliteTable::UNKNOWN_CONSTELLATION == SatelliteTable::constellationFromSystemID(6));
+
+    SatelliteTable t;
+    REQUIRE(0 == t.numberOfUsed());
+
+    REQUIRE(t.beginSentence(SatelliteTable::GPS, 0, 1, 1));
+    t.add(SatelliteTable::GPS, 4, 40, 83, 46);
+    t.add(SatelliteTable::GPS, 7, 10, 200, SatelliteTable::NO_SNR);
+    REQUIRE(t.endSentence(SatelliteTable::GPS));
+
+    t.setUsed(SatelliteTable::GPS, (1ull << 4) | (1ull << 5));
+    t.setUsed(SatelliteTable::GLONASS, (1ull << 1) | (1ull << 2) | (1ull << 3));
+    t.setUsed(SatelliteTable::UNKNOWN_CONSTELLATION, 1ull);
+    REQUIRE(5 == t.numberOfUsed());
+    REQUIRE((1ull << 4) == t.usedInView(SatelliteTable::GPS));
+    REQUIRE(0 == t.usedInView(SatelliteTable::GLONASS));
+
+    t.setUsed(SatelliteTable::GLONASS, 0);
+    REQUIRE(2 == t.numberOfUsed());
+}
+
+TEST_CASE("Test SatelliteTable maps PRN ranges to constellations.") {
+    struct Expected {
+        SatelliteTable::Constellation talker;
+        uint32_t prn;
+        SatelliteTable::Constellation constellation;
+        uint32_t slot;
+    };
+    const Expected EXPECTED[] = {
+        {SatelliteTable::GPS, 1, SatelliteTable::GPS, 1},
+        {SatelliteTable::GPS, 32, SatelliteTable::GPS, 32},
+        // SBAS in NMEA numbering and as PRN collide with GPS modulo 64.
+        {SatelliteTable::GPS, 46, SatelliteTable::SBAS, 13},
+        {SatelliteTable::GPS, 133, SatelliteTable::SBAS, 13},
+        {SatelliteTable::GPS, 131, SatelliteTable::SBAS, 11},
+        {SatelliteTable::GPS, 193, SatelliteTable::QZSS, 1},
+        {SatelliteTable::UNKNOWN_CONSTELLATION, 70, SatelliteTable::GLONASS, 6},
+        {SatelliteTable::GLONASS, 70, SatelliteTable::GLONASS, 6},
+        {SatelliteTable::GLONASS, 6, SatelliteTable::GLONASS, 6},
+        {SatelliteTable::GALILEO, 36, SatelliteTable::GALILEO, 36},
+        {SatelliteTable::GALILEO, 301, SatelliteTable::GALILEO, 1},
+        {SatelliteTable::BEIDOU, 63, SatelliteTable::BEIDOU, 63},
+        {SatelliteTable::BEIDOU, 201, SatelliteTable::BEIDOU, 1},
+        {SatelliteTable::BEIDOU, 437, SatelliteTable::BEIDOU, 37},
+        {SatelliteTable::QZSS, 2, SatelliteTable::QZSS, 2},
+    };
+    for (const auto &e : EXPECTED) {
+        SatelliteTable::Constellation c{SatelliteTable::UNKNOWN_CONSTELLATION};
+        uint32_t slot{0};
+        REQUIRE(SatelliteTable::locate(e.talker, e.prn, c, slot));
+        REQUIRE(e.constellation == c);
+        REQUIRE(e.slot == slot);
+    }
+
+    SatelliteTable::Constellation c{SatelliteTable::UNKNOWN_CONSTELLATION};
+    uint32_t slot{0};
+    REQUIRE(!SatelliteTable::locate(SatelliteTable::GPS, 0, c, slot));
+    REQUIRE(!SatelliteTable::locate(SatelliteTable::GPS, 99, c, slot));
+    REQUIRE(!SatelliteTable::locate(SatelliteTable::QZSS, 11, c, slot));
+}
+
+TEST_CASE("Test SatelliteTable keeps SBAS apart from GPS.") {
+    SatelliteTable t;
+    REQUIRE(t.beginSentence(SatelliteTable::GPS, 0, 1, 1));
+    t.add(SatelliteTable::GPS, 3, 40, 83, 46);
+    t.add(SatelliteTable::GPS, 131, 30, 180, 38);
+    const uint32_t COMPLETED{t.endSentence(SatelliteTable::GPS)};
+    REQUIRE(((1u << SatelliteTable::GPS) | (1u << SatelliteTable::SBAS)) == COMPLETED);
+    REQUIRE((1ull << 3) == t.inView(SatelliteTable::GPS));
+    REQUIRE((1ull << 11) == t.inView(SatelliteTable::SBAS));
+    REQUIRE(3 == t.prn(SatelliteTable::GPS, 3));
+    REQUIRE(46 == t.snr(SatelliteTable::GPS, 3));
+    REQUIRE(131 == t.prn(SatelliteTable::SBAS, 11));
+
+    // SBAS satellites no longer reported leave the view.
+    REQUIRE(t.beginSentence(SatelliteTable::GPS, 0, 1, 1));
+    t.add(SatelliteTable::GPS, 3, 40, 83, 46);
+    REQUIRE(((1u << SatelliteTable::GPS) | (1u << SatelliteTable::SBAS)) == t.endSentence(SatelliteTable::GPS));
+    REQUIRE(0 == t.inView(SatelliteTable::SBAS));
+}
+
+TEST_CASE("Test SatelliteTable keeps the lowest signal ID.") {
+    SatelliteTable t;
+    REQUIRE(t.beginSentence(SatelliteTable::GPS, 1, 1, 1));
+    t.add(SatelliteTable::GPS, 3, 40, 83, 46);
+    REQUIRE(0 != t.endSentence(SatelliteTable::GPS));
+
+    // A second signal does neither overwrite the SNR nor the view.
+    REQUIRE(!t.beginSentence(SatelliteTable::GPS, 8, 1, 1));
+    REQUIRE(46 == t.snr(SatelliteTable::GPS, 3));
+    REQUIRE((1ull << 3) == t.inView(SatelliteTable::GPS));
+
+    REQUIRE(t.beginSentence(SatelliteTable::GPS, 1, 1, 1));
+    t.add(SatelliteTable::GPS, 3, 40, 83, 44);
+    REQUIRE(0 != t.endSentence(SatelliteTable::GPS));
+    REQUIRE(44 == t.snr(SatelliteTable::GPS, 3));
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "stationary-detector.hpp"
+
+#include <chrono>
+
+namespace {
+    constexpr double METERS_PER_DEGREE_LATITUDE{111412.9};   /*at 57.7 degrees*/
+}
+
+TEST_CASE("Test StationaryDetector with parked vehicle starting to drive.") {
+    StationaryDetector d;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    // Noise of +/-0.3 m at 10 Hz for 4.5 s.
+    for (uint32_t i{0}; i < 45; i++) {
+        const double NOISE{(0 == i % 2) ? 0.3 : -0.3};
+        d.setPosition(57.7 + NOISE / METERS_PER_DEGREE_LATITUDE, 11.9, tp);
+        d.setSpeed(0.05f, tp);
+        // Window of one second plus three seconds of holding still.
+        REQUIRE((39 <= i) == d.isStationary());
+        tp += std::chrono::milliseconds(100);
+    }
+
+    // Below the limit to become moving again.
+    d.setSpeed(0.4f, tp);
+    REQUIRE(d.isStationary());
+    d.setSpeed(1.0f, tp);
+    REQUIRE(!d.isStationary());
+}
+
+TEST_CASE("Test StationaryDetector without speed and creeping.") {
+    StationaryDetector d;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    double north{0.0};
+    for (uint32_t i{0}; i < 50; i++) {
+        d.setPosition(57.7, 11.9, tp);
+        tp += std::chrono::milliseconds(100);
+    }
+    REQUIRE(d.isStationary());
+
+    // Creeping at 0.25 m/s is detected after 3 m.
+    uint32_t moving{0};
+    for (uint32_t i{0}; i < 200; i++) {
+        north += 0.025;
+        d.setPosition(57.7 + north / METERS_PER_DEGREE_LATITUDE, 11.9, tp);
+        if (!d.isStationary()) {
+            moving = (0 == moving) ? i : moving;
+        }
+        tp += std::chrono::milliseconds(100);
+    }
+    REQUIRE(100 < moving);
+    REQUIRE(130 > moving);
+}
+
+TEST_CASE("Test StationaryDetector starts over after a gap.") {
+    StationaryDetector d;
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(1000)};
+    for (uint32_t i{0}; i < 50; i++) {
+        d.setPosition(57.7, 11.9, tp);
+        tp += std::chrono::milliseconds(100);
+    }
+    REQUIRE(d.isStationary());
+    d.setPosition(57.7, 11.9, tp + std::chrono::seconds(10));
+    REQUIRE(!d.isStationary());
+}
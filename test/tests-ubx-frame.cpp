@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "ubx-frame.hpp"
+
+#include <cstdint>
+
+TEST_CASE("Test UBXFrame with checksum of UBX-MON-VER poll.") {
+    const uint8_t FRAME[]{0xB5, 0x62, 0x0A, 0x04, 0x00, 0x00, 0x0E, 0x34};
+
+    REQUIRE(UBXFrame::isSync(FRAME, sizeof(FRAME)));
+    REQUIRE(!UBXFrame::isSync(FRAME + 1, sizeof(FRAME) - 1));
+    REQUIRE(8 == UBXFrame::length(FRAME));
+    REQUIRE(UBXFrame::isValid(FRAME, sizeof(FRAME)));
+
+    uint8_t corrupted[sizeof(FRAME)];
+    for (size_t i{0}; i < sizeof(FRAME); i++) {
+        corrupted[i] = FRAME[i];
+    }
+    corrupted[7] = 0x35;
+    REQUIRE(!UBXFrame::isValid(corrupted, sizeof(corrupted)));
+}
+
+TEST_CASE("Test UBXFrame with little-endian loads.") {
+    const uint8_t DATA[]{0x78, 0x56, 0x34, 0x12, 0xFE, 0xFF, 0xFF, 0xFF};
+
+    REQUIRE(0x5678 == UBXFrame::load<uint16_t>(DATA));
+    REQUIRE(0x12345678 == UBXFrame::load<uint32_t>(DATA));
+    REQUIRE(-2 == UBXFrame::load<int32_t>(DATA + 4));
+}
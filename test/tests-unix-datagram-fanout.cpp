@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "unix-datagram-fanout.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace {
+int32_t bindAbstract(const std::string &name) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path + 1, name.data(), name.size());
+    int32_t s = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    ::bind(s, reinterpret_cast<sockaddr*>(&address), static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size()));
+    return s;
+}
+
+void attach(const int32_t &s, const std::string &name) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path + 1, name.data(), name.size());
+    ::sendto(s, "x", 1, 0, reinterpret_cast<sockaddr*>(&address), static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size()));
+}
+}
+
+TEST_CASE("Test UNIXDatagramFanOut with invalid path.") {
+    UNIXDatagramFanOut f{""};
+    REQUIRE(!f.isRunning());
+    f.send("abc", 3);
+}
+
+TEST_CASE("Test UNIXDatagramFanOut does not replace files other than sockets.") {
+    const std::string PATH{"tests-unix-datagram-fanout.txt"};
+    {
+        std::ofstream file(PATH.c_str());
+        file << "keep";
+    }
+    {
+        UNIXDatagramFanOut f{PATH};
+        REQUIRE(!f.isRunning());
+    }
+    std::ifstream file(PATH.c_str());
+    std::string content;
+    file >> content;
+    REQUIRE("keep" == content);
+    std::remove(PATH.c_str());
+}
+
+TEST_CASE("Test UNIXDatagramFanOut replaces a stale socket.") {
+    const std::string PATH{"tests-unix-datagram-fanout.sock"};
+    {
+        UNIXDatagramFanOut f{PATH};
+        REQUIRE(f.isRunning());
+    }
+    // Left behind as after a crash.
+    const int32_t s{::socket(AF_UNIX, SOCK_DGRAM, 0)};
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, PATH.data(), PATH.size());
+    REQUIRE(0 == ::bind(s, reinterpret_cast<sockaddr*>(&address), static_cast<socklen_t>(sizeof(address))));
+    ::close(s);
+
+    UNIXDatagramFanOut f{PATH};
+    REQUIRE(f.isRunning());
+}
+
+TEST_CASE("Test UNIXDatagramFanOut passes datagrams to all attached readers.") {
+    const std::string NAME{"tests-unix-datagram-fanout"};
+    UNIXDatagramFanOut f{"@" + NAME};
+    REQUIRE(f.isRunning());
+
+    // Nobody attached yet.
+    f.send("$A\r\n", 4);
+    REQUIRE(0 == f.numberOfReaders());
+
+    int32_t r1 = bindAbstract(NAME + "-r1");
+    int32_t r2 = bindAbstract(NAME + "-r2");
+    attach(r1, NAME);
+    attach(r2, NAME);
+    attach(r2, NAME);
+
+    const std::string SENTENCE{"$GPGGA,172814.0,3723.46587704,N,12202.26957864,W,2,6,1.2,18.893,M,-25.669,M,2.0,0031*4F\r\n"};
+    f.send(SENTENCE.data(), SENTENCE.size());
+    REQUIRE(2 == f.numberOfReaders());
+
+    char buffer[256];
+    REQUIRE(static_cast<ssize_t>(SENTENCE.size()) == ::recv(r1, buffer, sizeof(buffer), MSG_DONTWAIT));
+    REQUIRE(SENTENCE == std::string(buffer, SENTENCE.size()));
+    REQUIRE(static_cast<ssize_t>(SENTENCE.size()) == ::recv(r2, buffer, sizeof(buffer), MSG_DONTWAIT));
+
+    // Readers that went away are detached.
+    ::close(r1);
+    f.send(SENTENCE.data(), SENTENCE.size());
+    REQUIRE(1 == f.numberOfReaders());
+    REQUIRE(static_cast<ssize_t>(SENTENCE.size()) == ::recv(r2, buffer, sizeof(buffer), MSG_DONTWAIT));
+
+    // Slow readers never block the sender.
+    for (uint32_t i{0}; i < 10000; i++) {
+        f.send(SENTENCE.data(), SENTENCE.size());
+    }
+    REQUIRE(0 < f.droppedDatagrams());
+    REQUIRE(1 == f.numberOfReaders());
+    ::close(r2);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+
+#include "utm-projection.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("Test UTMProjection zones.") {
+    REQUIRE(31 == UTMProjection::zone(0.0, 3.0));
+    REQUIRE(1 == UTMProjection::zone(0.0, -180.0));
+    REQUIRE(1 == UTMProjection::zone(0.0, 180.0));
+    REQUIRE(60 == UTMProjection::zone(0.0, 179.9));
+    REQUIRE(33 == UTMProjection::zone(57.7, 12.0));
+    // Norway and Svalbard.
+    REQUIRE(32 == UTMProjection::zone(60.4, 5.3));
+    REQUIRE(31 == UTMProjection::zone(64.0, 5.3));
+    REQUIRE(33 == UTMProjection::zone(78.2, 15.6));
+    REQUIRE(35 == UTMProjection::zone(78.2, 21.0));
+
+    UTMProjection p{61, false};
+    REQUIRE(1 == p.zone());
+    REQUIRE(!p.isNorth());
+}
+
+TEST_CASE("Test UTMProjection on the central meridian.") {
+    UTMProjection p{32, true};
+    double easting{0.0};
+    double northing{0.0};
+    p.toUTM(0.0, 9.0, easting, northing);
+    REQUIRE(1e-6 > std::fabs(easting - 500000.0));
+    REQUIRE(1e-6 > std::fabs(northing));
+
+    // Scaled meridian arc length from numerical integration.
+    p.toUTM(45.0, 9.0, easting, northing);
+    REQUIRE(1e-6 > std::fabs(easting - 500000.0));
+    REQUIRE(1e-3 > std::fabs(northing - 4982950.4002));
+}
+
+TEST_CASE("Test UTMProjection off the central meridian.") {
+    // References from Snyder's series (USGS Professional Paper 1395).
+    struct Reference {
+        double latitude;
+        double longitude;
+        uint32_t zone;
+        double easting;
+        double northing;
+    };
+    const std::array<Reference, 3> REFERENCES{{
+        {57.70887, 11.97456, 32, 677214.4489, 6400188.5650},
+        {-33.8688, 151.2093, 56, 334368.6336, 6250948.3454},
+        {60.0, 1.0, 31, 388455.9580, 6653097.4353}
+    }};
+    for (const Reference &r : REFERENCES) {
+        UTMProjection p{r.zone, 0.0 <= r.latitude};
+        double easting{0.0};
+        double northing{0.0};
+        p.toUTM(r.latitude, r.longitude, easting, northing);
+        REQUIRE(5e-3 > std::fabs(easting - r.easting));
+        REQUIRE(5e-3 > std::fabs(northing - r.northing));
+    }
+}
+
+TEST_CASE("Test UTMProjection batch matches single positions.") {
+    // Grid from pole to pole within 20 degrees of the central meridian and
+    // across the zone's boundaries.
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    for (int32_t i{0}; i <= 180; i++) {
+        for (int32_t j{-20}; j <= 20; j++) {
+            latitude.push_back(-90.0 + i * 1.0);
+            longitude.push_back(9.0 + j * 1.0 + 0.123456789 * ((0 < j) ? -1.0 : 1.0));
+        }
+    }
+    latitude.push_back(59.3);
+    longitude.push_back(9.0 + 360.0);
+
+    const size_t COUNT{latitude.size()};
+    UTMProjection p{32, true};
+    std::vector<double> easting(COUNT);
+    std::vector<double> northing(COUNT);
+    p.toUTM(latitude.data(), longitude.data(), easting.data(), northing.data(), COUNT);
+
+    double maxError{0.0};
+    for (size_t i{0}; i < COUNT; i++) {
+        double e{0.0};
+        double n{0.0};
+        p.toUTM(latitude[i], longitude[i], e, n);
+        maxError = std::fmax(maxError, std::fabs(e - easting[i]));
+        maxError = std::fmax(maxError, std::fabs(n - northing[i]));
+    }
+    REQUIRE(1e-6 > maxError);
+}